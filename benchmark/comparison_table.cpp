@@ -1,4 +1,5 @@
-/* Comparison table for several configurations of boost::bloom::filter.
+/* Comparison table for several configurations of boost::bloom::filter
+ * and boost::bloom::cuckoo_filter.
  * 
  * Copyright 2025 Joaquin M Lopez Munoz.
  * Distributed under the Boost Software License, Version 1.0.
@@ -72,8 +73,18 @@ struct unordered_flat_set_filter
 
   unordered_flat_set_filter(std::size_t){}
   void insert(const T& x){s.insert(x);}
+
+  template<typename Iterator>
+  void insert(Iterator first,Iterator last){s.insert(first,last);}
+
   bool may_contain(const T& x){return s.contains(x);}
 
+  template<typename Iterator,typename F>
+  void may_contain(Iterator first,Iterator last,F f)
+  {
+    for(;first!=last;++first)f(*first,s.contains(*first));
+  }
+
   boost::unordered_flat_set<T> s;
 };
 
@@ -85,6 +96,9 @@ struct test_results
   double insertion_time;           /* ns per element */
   double successful_lookup_time;   /* ns per element */
   double unsuccessful_lookup_time; /* ns per element */
+  double bulk_insertion_time;           /* ns per element */
+  double bulk_successful_lookup_time;   /* ns per element */
+  double bulk_unsuccessful_lookup_time; /* ns per element */
 };
 
 template<typename Filter>
@@ -160,7 +174,49 @@ test_results test(std::size_t c)
     unsuccessful_lookup_time=t/num_elements*1E9;
   }
 
-  return {fpr,insertion_time,successful_lookup_time,unsuccessful_lookup_time};
+  double bulk_insertion_time=0.0;
+  {
+    double t=measure([&]{
+      pause_timing();
+      {
+        Filter f(c*num_elements);
+        resume_timing();
+        f.insert(data_in.begin(),data_in.end());
+        pause_timing();
+      }
+      resume_timing();
+      return 0;
+    });
+    bulk_insertion_time=t/num_elements*1E9;
+  }
+
+  double bulk_successful_lookup_time=0.0;
+  double bulk_unsuccessful_lookup_time=0.0;
+  {
+    Filter f(c*num_elements);
+    f.insert(data_in.begin(),data_in.end());
+    double t=measure([&]{
+      std::size_t res=0;
+      f.may_contain(
+        data_in.begin(),data_in.end(),
+        [&](const value_type&,bool b){res+=b;});
+      return res;
+    });
+    bulk_successful_lookup_time=t/num_elements*1E9;
+    t=measure([&]{
+      std::size_t res=0;
+      f.may_contain(
+        data_out.begin(),data_out.end(),
+        [&](const value_type&,bool b){res+=b;});
+      return res;
+    });
+    bulk_unsuccessful_lookup_time=t/num_elements*1E9;
+  }
+
+  return {
+    fpr,insertion_time,successful_lookup_time,unsuccessful_lookup_time,
+    bulk_insertion_time,bulk_successful_lookup_time,
+    bulk_unsuccessful_lookup_time};
 }
 
 struct print_double
@@ -196,7 +252,49 @@ template<typename Filters> void row(std::size_t c)
       "    <td align=\"right\">"<<print_double(res.fpr,4)<<"</td>\n"
       "    <td align=\"right\">"<<print_double(res.insertion_time)<<"</td>\n"
       "    <td align=\"right\">"<<print_double(res.successful_lookup_time)<<"</td>\n"
-      "    <td align=\"right\">"<<print_double(res.unsuccessful_lookup_time)<<"</td>\n";
+      "    <td align=\"right\">"<<print_double(res.unsuccessful_lookup_time)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.bulk_insertion_time)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.bulk_successful_lookup_time)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.bulk_unsuccessful_lookup_time)<<"</td>\n";
+  });
+
+  std::cout<<
+    "  </tr>\n";
+}
+
+/* Cuckoo filters with c bits per element have a load factor of around
+ * FingerprintBits/c. Configurations beyond max_load_factor() can't hold
+ * all the elements and are not measured.
+ */
+
+template<typename Filters> void cuckoo_row(std::size_t c)
+{
+  std::cout<<
+    "  <tr>\n"
+    "    <td align=\"center\">"<<c<<"</td>\n";
+
+  boost::mp11::mp_for_each<
+    boost::mp11::mp_transform<boost::mp11::mp_identity,Filters>
+  >([&](auto i){
+    using filter=typename decltype(i)::type;
+    double load=(double)num_elements*filter::fingerprint_bits/
+                filter{c*num_elements}.capacity();
+    std::cout<<
+      "    <td align=\"center\">"<<filter::fingerprint_bits<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(load)<<"</td>\n";
+    if(load>filter::max_load_factor()){
+      for(int j=0;j<7;++j)std::cout<<"    <td align=\"center\">n/a</td>\n";
+      return;
+    }
+    auto res=test<filter>(c);
+    std::cout<<
+      "    <td align=\"right\">"<<print_double(res.fpr,4)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.insertion_time)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.successful_lookup_time)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.unsuccessful_lookup_time)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.bulk_insertion_time)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.bulk_successful_lookup_time)<<"</td>\n"
+      "    <td align=\"right\">"<<print_double(res.bulk_unsuccessful_lookup_time)<<"</td>\n";
   });
 
   std::cout<<
@@ -205,6 +303,25 @@ template<typename Filters> void row(std::size_t c)
 
 using namespace boost::bloom;
 
+/* SIMD variant used by fast_multiblock32 (fast_multiblock64 falls back to
+ * non-SIMD code when neither AVX2 nor Neon is available).
+ */
+
+const char* simd_variant()
+{
+#if defined(BOOST_BLOOM_AVX512)
+  return "AVX-512";
+#elif defined(BOOST_BLOOM_AVX2)
+  return "AVX2";
+#elif defined(BOOST_BLOOM_SSE2)
+  return "SSE2";
+#elif defined(BOOST_BLOOM_LITTLE_ENDIAN_NEON)
+  return "Neon";
+#else
+  return "none";
+#endif
+}
+
 template<std::size_t K1,std::size_t K2,std::size_t K3>
 using filters1=boost::mp11::mp_list<
   filter<int,K1>,
@@ -233,6 +350,13 @@ using filters4=boost::mp11::mp_list<
   filter<int,1,multiblock<std::uint64_t[8],K3>>
 >;
 
+template<std::size_t F1,std::size_t F2,std::size_t F3>
+using cuckoo_filters=boost::mp11::mp_list<
+  cuckoo_filter<int,F1,2>,
+  cuckoo_filter<int,F2,4>,
+  cuckoo_filter<int,F3,8>
+>;
+
 int main(int argc,char* argv[])
 {
   if(argc<2){
@@ -247,21 +371,29 @@ int main(int argc,char* argv[])
     return EXIT_FAILURE;
   }
 
+  std::cout<<"<p>fast_multiblock SIMD variant: "<<simd_variant()<<"</p>\n";
+
   /* reference table: boost::unordered_flat_set */
 
   auto res=test<unordered_flat_set_filter<int>>(0);
   std::cout<<
     "<table>\n"
-    "  <tr><th colspan=\"3\"><code>boost::unordered_flat_set</code></tr>\n"
+    "  <tr><th colspan=\"6\"><code>boost::unordered_flat_set</code></tr>\n"
     "  <tr>\n"
     "    <th>insertion</th>\n"
     "    <th>successful<br/>lookup</th>\n"
     "    <th>unsuccessful<br/>lookup</th>\n"
+    "    <th>bulk<br/>insertion</th>\n"
+    "    <th>bulk<br/>successful<br/>lookup</th>\n"
+    "    <th>bulk<br/>unsuccessful<br/>lookup</th>\n"
     "  </tr>\n"
     "  <tr>\n"
     "    <td align=\"right\">"<<print_double(res.insertion_time)<<"</td>\n"
     "    <td align=\"right\">"<<print_double(res.successful_lookup_time)<<"</td>\n"
     "    <td align=\"right\">"<<print_double(res.unsuccessful_lookup_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.bulk_insertion_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.bulk_successful_lookup_time)<<"</td>\n"
+    "    <td align=\"right\">"<<print_double(res.bulk_unsuccessful_lookup_time)<<"</td>\n"
     "  </tr>\n"
     "</table>\n";
 
@@ -272,15 +404,18 @@ int main(int argc,char* argv[])
     "    <th>FPR<br/>[%]</th>\n"
     "    <th>ins.</th>\n"
     "    <th>succ.<br/>lkp.</th>\n"
-    "    <th>uns.<br/>lkp.</th>\n";
+    "    <th>uns.<br/>lkp.</th>\n"
+    "    <th>bulk<br/>ins.</th>\n"
+    "    <th>bulk<br/>succ.<br/>lkp.</th>\n"
+    "    <th>bulk<br/>uns.<br/>lkp.</th>\n";
 
   std::cout<<
     "<table>\n"
     "  <tr>\n"
     "    <th></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;int,K></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;int,1,block&lt;uint64_t,K>></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;int,1,block&lt;uint64_t,K>,1></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;int,K></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;int,1,block&lt;uint64_t,K>></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;int,1,block&lt;uint64_t,K>,1></code></th>\n"
     "  </tr>\n"
     "  <tr>\n"
     "    <th>c</th>\n"<<
@@ -297,9 +432,9 @@ int main(int argc,char* argv[])
   std::cout<<
     "  <tr>\n"
     "    <th></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;int,1,multiblock&lt;uint64_t,K>></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;int,1,multiblock&lt;uint64_t,K>,1></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;int,1,fast_multiblock32&lt;K>></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;int,1,multiblock&lt;uint64_t,K>></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;int,1,multiblock&lt;uint64_t,K>,1></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;int,1,fast_multiblock32&lt;K>></code></th>\n"
     "  </tr>\n"
     "  <tr>\n"
     "    <th>c</th>\n"<<
@@ -316,9 +451,9 @@ int main(int argc,char* argv[])
   std::cout<<
     "  <tr>\n"
     "    <th></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;int,1,fast_multiblock32&lt;K>,1></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;int,1,fast_multiblock64&lt;K>></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;int,1,fast_multiblock64&lt;K>,1></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;int,1,fast_multiblock32&lt;K>,1></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;int,1,fast_multiblock64&lt;K>></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;int,1,fast_multiblock64&lt;K>,1></code></th>\n"
     "  </tr>\n"
     "  <tr>\n"
     "    <th>c</th>\n"<<
@@ -335,9 +470,9 @@ int main(int argc,char* argv[])
   std::cout<<
     "  <tr>\n"
     "    <th></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;int,1,block&lt;uint64_t[8],K>></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;int,1,block&lt;uint64_t[8],K>,1></code></th>\n"
-    "    <th colspan=\"5\"><code>filter&lt;int,1,multiblock&lt;uint64_t[8],K>></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;int,1,block&lt;uint64_t[8],K>></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;int,1,block&lt;uint64_t[8],K>,1></code></th>\n"
+    "    <th colspan=\"8\"><code>filter&lt;int,1,multiblock&lt;uint64_t[8],K>></code></th>\n"
     "  </tr>\n"
     "  <tr>\n"
     "    <th>c</th>\n"<<
@@ -352,4 +487,45 @@ int main(int argc,char* argv[])
   row<filters4<12, 12, 15>>(20);
 
   std::cout<<"</table>\n";
+
+  /* cuckoo filter table */
+
+  auto cuckoo_subheader=
+    "    <th>F</th>\n"
+    "    <th>load</th>\n"
+    "    <th>FPR<br/>[%]</th>\n"
+    "    <th>ins.</th>\n"
+    "    <th>succ.<br/>lkp.</th>\n"
+    "    <th>uns.<br/>lkp.</th>\n"
+    "    <th>bulk<br/>ins.</th>\n"
+    "    <th>bulk<br/>succ.<br/>lkp.</th>\n"
+    "    <th>bulk<br/>uns.<br/>lkp.</th>\n";
+
+  std::cout<<
+    "<table>\n"
+    "  <tr>\n"
+    "    <th></th>\n"
+    "    <th colspan=\"9\"><code>cuckoo_filter&lt;int,F,2></code><br/>"
+    "max. load "<<print_double(cuckoo_filter<int,8,2>::max_load_factor())<<
+    "</th>\n"
+    "    <th colspan=\"9\"><code>cuckoo_filter&lt;int,F,4></code><br/>"
+    "max. load "<<print_double(cuckoo_filter<int,8,4>::max_load_factor())<<
+    "</th>\n"
+    "    <th colspan=\"9\"><code>cuckoo_filter&lt;int,F,8></code><br/>"
+    "max. load "<<print_double(cuckoo_filter<int,8,8>::max_load_factor())<<
+    "</th>\n"
+    "  </tr>\n"
+    "  <tr>\n"
+    "    <th>c</th>\n"<<
+    cuckoo_subheader<<
+    cuckoo_subheader<<
+    cuckoo_subheader<<
+    "  </tr>\n";
+
+  cuckoo_row<cuckoo_filters< 6,  7,  7>>( 8);
+  cuckoo_row<cuckoo_filters< 9, 10,  8>>(12);
+  cuckoo_row<cuckoo_filters<12, 13,  8>>(16);
+  cuckoo_row<cuckoo_filters<15, 16,  8>>(20);
+
+  std::cout<<"</table>\n";
 }
@@ -0,0 +1,171 @@
+/* Scalability of boost::bloom::concurrent_filter with the number of threads.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <algorithm>
+#include <boost/bloom.hpp>
+#include <boost/bloom/concurrent_filter.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::size_t num_elements;
+static std::size_t max_threads;
+
+/* Runs f(first,last) on num_threads threads over equal-sized, disjoint
+ * slices of data and returns the wall time in ns per element.
+ */
+
+template<typename T,typename F>
+double run(const std::vector<T>& data,std::size_t num_threads,F f)
+{
+  using namespace std::chrono;
+
+  auto                     t0=high_resolution_clock::now();
+  std::vector<std::thread> threads;
+  for(std::size_t i=0;i<num_threads;++i){
+    threads.emplace_back([&,i]{
+      f(data.begin()+i*data.size()/num_threads,
+        data.begin()+(i+1)*data.size()/num_threads);
+    });
+  }
+  for(auto& th:threads)th.join();
+  auto t1=high_resolution_clock::now();
+  return duration_cast<duration<double>>(t1-t0).count()/data.size()*1E9;
+}
+
+/* Reference: a regular filter protected by a mutex, with bulk insertion
+ * done in chunks to amortize locking.
+ */
+
+template<typename Filter>
+struct locked_filter
+{
+  using value_type=typename Filter::value_type;
+
+  locked_filter(std::size_t m):f(m){}
+
+  template<typename Iterator>
+  void insert(Iterator first,Iterator last)
+  {
+    while(first!=last){
+      auto mid=first+(std::min)(std::size_t(last-first),std::size_t(1024));
+      std::lock_guard<std::mutex> lck(mut);
+      f.insert(first,mid);
+      first=mid;
+    }
+  }
+
+  bool may_contain(const value_type& x)
+  {
+    std::lock_guard<std::mutex> lck(mut);
+    return f.may_contain(x);
+  }
+
+  std::mutex mut;
+  Filter     f;
+};
+
+template<typename Filter>
+void row(const char* name,std::size_t c)
+{
+  using value_type=typename Filter::value_type;
+
+  std::vector<value_type> data;
+  boost::detail::splitmix64 rng;
+  for(std::size_t i=0;i<num_elements;++i)data.push_back(value_type(rng()));
+
+  std::cout<<
+    "  <tr>\n"
+    "    <td><code>"<<name<<"</code></td>\n";
+  for(std::size_t n=1;n<=max_threads;n*=2){
+    Filter f(c*num_elements);
+    auto   tins=run(data,n,[&](
+      typename std::vector<value_type>::const_iterator first,
+      typename std::vector<value_type>::const_iterator last){
+      f.insert(first,last);
+    });
+    std::size_t res=0;
+    std::mutex  mut;
+    auto        tlkp=run(data,n,[&](
+      typename std::vector<value_type>::const_iterator first,
+      typename std::vector<value_type>::const_iterator last){
+      std::size_t r=0;
+      for(;first!=last;++first)r+=f.may_contain(*first);
+      std::lock_guard<std::mutex> lck(mut);
+      res+=r;
+    });
+    if(res!=data.size())std::cerr<<"unexpected negative\n";
+    std::cout<<
+      "    <td align=\"right\">"<<std::fixed<<std::setprecision(2)<<tins<<
+      "</td>\n"
+      "    <td align=\"right\">"<<tlkp<<"</td>\n";
+  }
+  std::cout<<
+    "  </tr>\n";
+}
+
+using namespace boost::bloom;
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"provide the number of elements\n";
+    return EXIT_FAILURE;
+  }
+  try{
+    num_elements=std::stoul(argv[1]);
+    max_threads=argc>2?
+      std::stoul(argv[2]):
+      (std::max)(std::thread::hardware_concurrency(),1u);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  std::cout<<
+    "<table>\n"
+    "  <tr>\n"
+    "    <th>ns per element</th>\n";
+  for(std::size_t n=1;n<=max_threads;n*=2){
+    std::cout<<"    <th colspan=\"2\">"<<n<<" thread(s)</th>\n";
+  }
+  std::cout<<
+    "  </tr>\n"
+    "  <tr>\n"
+    "    <th></th>\n";
+  for(std::size_t n=1;n<=max_threads;n*=2){
+    std::cout<<"    <th>ins.</th>\n    <th>lkp.</th>\n";
+  }
+  std::cout<<
+    "  </tr>\n";
+
+  row<locked_filter<filter<int,1,block<std::uint64_t,6>>>>(
+    "mutex + filter&lt;int,1,block&lt;uint64_t,6>>",12);
+  row<concurrent_filter<int,1,block<std::uint64_t,6>>>(
+    "concurrent_filter&lt;int,1,block&lt;uint64_t,6>>",12);
+  row<concurrent_filter<int,1,multiblock<std::uint64_t,8>>>(
+    "concurrent_filter&lt;int,1,multiblock&lt;uint64_t,8>>",12);
+  row<concurrent_filter<int,1,fast_multiblock32<8>>>(
+    "concurrent_filter&lt;int,1,fast_multiblock32&lt;8>>",12);
+  row<concurrent_filter<int,1,fast_multiblock64<8>>>(
+    "concurrent_filter&lt;int,1,fast_multiblock64&lt;8>>",12);
+
+  std::cout<<"</table>\n";
+}
@@ -0,0 +1,133 @@
+/* Lookup performance of large filters with std::allocator versus
+ * boost::bloom::huge_page_allocator.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/fast_multiblock32.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/huge_page_allocator.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+static std::size_t num_elements=10000000;
+
+template<typename F>
+double measure(F f)
+{
+  using namespace std::chrono;
+
+  auto t0=high_resolution_clock::now();
+  f();
+  auto t1=high_resolution_clock::now();
+  return duration_cast<duration<double>>(t1-t0).count()/num_elements*1E9;
+}
+
+/* Times insertion, successful lookup and unsuccessful lookup of
+ * num_elements random values, in ns per element. Accesses to the array are
+ * random and, for filters of several GB, each one is likely to incur a TLB
+ * miss with regular pages.
+ */
+
+template<typename Allocator>
+void cells(std::size_t gb)
+{
+  using filter=boost::bloom::filter<
+    std::uint64_t,1,boost::bloom::fast_multiblock32<8>,0,
+    boost::hash<std::uint64_t>,Allocator>;
+
+  std::vector<std::uint64_t> data,data2;
+  boost::detail::splitmix64  rng;
+  for(std::size_t i=0;i<num_elements;++i)data.push_back(rng());
+  for(std::size_t i=0;i<num_elements;++i)data2.push_back(rng());
+
+  std::size_t res=0;
+  double      tcons,tins,tlkp1,tlkp2;
+  {
+    std::unique_ptr<filter> pf;
+    tcons=measure([&]{
+      pf.reset(new filter((std::size_t)gb<<33));
+    })*num_elements/1E9;
+    auto& f=*pf;
+    tins=measure([&]{
+      for(const auto& x:data)f.insert(x);
+    });
+    tlkp1=measure([&]{
+      for(const auto& x:data)res+=f.may_contain(x);
+    });
+    tlkp2=measure([&]{
+      for(const auto& x:data2)res+=f.may_contain(x);
+    });
+  }
+  if(res<num_elements)std::cerr<<"unexpected negative\n";
+
+  std::cout<<
+    "    <td align=\"right\">"<<std::fixed<<std::setprecision(2)<<tcons<<
+    "</td>\n"
+    "    <td align=\"right\">"<<tins<<"</td>\n"
+    "    <td align=\"right\">"<<tlkp1<<"</td>\n"
+    "    <td align=\"right\">"<<tlkp2<<"</td>\n";
+}
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<
+      "usage: huge_pages num_elements size_in_GB [size_in_GB ...]\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::size_t> sizes;
+  try{
+    num_elements=std::stoul(argv[1]);
+    for(int i=2;i<argc;++i)sizes.push_back(std::stoul(argv[i]));
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+  if(sizes.empty())sizes={4,8,16,32};
+
+  std::cout<<
+    "<table>\n"
+    "  <tr>\n"
+    "    <th></th>\n"
+    "    <th colspan=\"4\"><code>std::allocator</code></th>\n"
+    "    <th colspan=\"4\"><code>huge_page_allocator</code></th>\n"
+    "  </tr>\n"
+    "  <tr>\n"
+    "    <th>filter size</th>\n";
+  for(int i=0;i<2;++i){
+    std::cout<<
+      "    <th>constr.<br/>(s)</th>\n"
+      "    <th>insertion<br/>(ns)</th>\n"
+      "    <th>successful<br/>lookup (ns)</th>\n"
+      "    <th>unsuccessful<br/>lookup (ns)</th>\n";
+  }
+  std::cout<<
+    "  </tr>\n";
+
+  for(auto gb:sizes){
+    std::cout<<
+      "  <tr>\n"
+      "    <td>"<<gb<<" GB</td>\n";
+    cells<std::allocator<unsigned char>>(gb);
+    cells<boost::bloom::huge_page_allocator<>>(gb);
+    std::cout<<
+      "  </tr>\n";
+  }
+
+  std::cout<<"</table>\n";
+}
@@ -0,0 +1,110 @@
+/* Lookup latency of boost::bloom::numa_filter replicas from threads on
+ * each NUMA node.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/fast_multiblock32.hpp>
+#include <boost/bloom/numa_filter.hpp>
+#include <boost/core/detail/splitmix64.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using filter=boost::bloom::numa_filter<
+  std::uint64_t,1,boost::bloom::fast_multiblock32<8>>;
+
+static std::size_t num_elements;
+
+/* ns per lookup of f on data from a thread pinned to the CPUs of node */
+
+template<typename F>
+double measure(
+  const boost::bloom::detail::numa_node& node,
+  const std::vector<std::uint64_t>& data,F f)
+{
+  double res;
+  std::thread th([&]{
+    using namespace std::chrono;
+
+    boost::bloom::detail::pin_current_thread(node.cpus);
+    std::size_t r=0;
+    auto        t0=high_resolution_clock::now();
+    for(const auto& x:data)r+=f(x);
+    auto        t1=high_resolution_clock::now();
+    res=duration_cast<duration<double>>(t1-t0).count()/data.size()*1E9;
+    if(r<data.size())std::cerr<<"unexpected negative\n";
+  });
+  th.join();
+  return res;
+}
+
+int main(int argc,char* argv[])
+{
+  if(argc<2){
+    std::cerr<<"usage: numa_lookup num_elements [size_in_GB]\n";
+    return EXIT_FAILURE;
+  }
+
+  std::size_t gb=1;
+  try{
+    num_elements=std::stoul(argv[1]);
+    if(argc>2)gb=std::stoul(argv[2]);
+  }
+  catch(...){
+    std::cerr<<"wrong arg\n";
+    return EXIT_FAILURE;
+  }
+
+  const auto& nodes=boost::bloom::detail::get_numa_topology().nodes;
+
+  std::vector<std::uint64_t> data;
+  boost::detail::splitmix64  rng;
+  for(std::size_t i=0;i<num_elements;++i)data.push_back(rng());
+
+  filter f(gb<<33);
+  f.insert(data.begin(),data.end());
+
+  /* Successful lookups to avoid early termination. Columns are the nodes
+   * the replicas live on, rows the nodes the querying thread runs on.
+   */
+
+  std::cout<<
+    "<table>\n"
+    "  <tr>\n"
+    "    <th>ns per lookup</th>\n";
+  for(const auto& node:nodes){
+    std::cout<<"    <th>replica on node "<<node.id<<"</th>\n";
+  }
+  std::cout<<
+    "    <th><code>numa_filter::may_contain</code></th>\n"
+    "  </tr>\n";
+  for(const auto& node:nodes){
+    std::cout<<
+      "  <tr>\n"
+      "    <td>thread on node "<<node.id<<"</td>\n";
+    for(std::size_t i=0;i<nodes.size();++i){
+      const auto& r=f.replica(i);
+      std::cout<<
+        "    <td align=\"right\">"<<std::fixed<<std::setprecision(2)<<
+        measure(node,data,[&](std::uint64_t x){return r.may_contain(x);})<<
+        "</td>\n";
+    }
+    std::cout<<
+      "    <td align=\"right\">"<<
+      measure(node,data,[&](std::uint64_t x){return f.may_contain(x);})<<
+      "</td>\n"
+      "  </tr>\n";
+  }
+  std::cout<<"</table>\n";
+}
@@ -33,6 +33,9 @@
  * resulting FPR oscillates between 1 - (1 - sub_fpr)^(n-1) and 
  * 1 - (1 - sub_fpr)^n, where sub_fpr is the FPR of an individual filter
  * after w insertions.
+ *
+ * As all the filters share the same hash function, lookup calculates the
+ * hash value of the element once and then probes each filter with it.
  */
 
 template<
@@ -104,8 +107,9 @@ public:
 
   bool may_contain(const T& x) const
   {
+    auto hash = fs[0].hash_for(x);
     for(const auto& f: fs) {
-      if(f.may_contain(x)) return true;
+      if(f.may_contain_hash(hash)) return true;
     }
     return false;
   }
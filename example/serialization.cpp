@@ -10,6 +10,7 @@
 
 #include <boost/bloom/filter.hpp>
 #include <boost/bloom/multiblock.hpp>
+#include <boost/bloom/serialization.hpp>
 #include <boost/core/detail/splitmix64.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <cstdint>
@@ -40,6 +41,12 @@ using filter = boost::bloom::filter<
 
 static constexpr std::size_t num_elements = 10000;
 
+/* tag identifying the hash function (boost::hash<boost::uuids::uuid>),
+ * which the filter type alone doesn't capture
+ */
+
+static constexpr std::uint64_t hash_id = 1;
+
 /* creates a filter with num_elements UUIDs */
 
 filter create_filter()
@@ -53,20 +60,14 @@ filter create_filter()
 void save_filter(const filter& f, const char* filename)
 {
   std::ofstream out(filename, std::ios::binary | std::ios::trunc);
-  std::size_t c=f.capacity();
-  out.write(reinterpret_cast<const char*>(&c), sizeof(c)); /* save capacity (bits) */
-  auto s = f.array();
-  out.write(reinterpret_cast<const char*>(s.data()), s.size()); /* save array */
+  boost::bloom::save(f, out, hash_id); /* configuration, capacity, array and checksum */
 }
 
 filter load_filter(const char* filename)
 {
   std::ifstream in(filename, std::ios::binary);
-  std::size_t c;
-  in.read(reinterpret_cast<char*>(&c), sizeof(c));
-  filter f(c);
-  auto s = f.array();
-  in.read(reinterpret_cast<char*>(s.data()), s.size()); /* load array */
+  filter f;
+  boost::bloom::load(f, in, hash_id); /* throws if incompatible or corrupted */
   return f;
 }
 
@@ -10,9 +10,20 @@
 #define BOOST_BLOOM_HPP
 
 #include <boost/bloom/filter.hpp>
+#include <boost/bloom/concurrent_filter.hpp>
+#include <boost/bloom/dynamic_filter.hpp>
+#include <boost/bloom/filter_view.hpp>
+#include <boost/bloom/any_filter.hpp>
+#include <boost/bloom/numa_filter.hpp>
+#include <boost/bloom/counting_filter.hpp>
+#include <boost/bloom/cuckoo_filter.hpp>
+#include <boost/bloom/serialization.hpp>
+#include <boost/bloom/huge_page_allocator.hpp>
 #include <boost/bloom/block.hpp>
 #include <boost/bloom/multiblock.hpp>
 #include <boost/bloom/fast_multiblock32.hpp>
 #include <boost/bloom/fast_multiblock64.hpp>
+#include <boost/bloom/dispatched_fast_multiblock32.hpp>
+#include <boost/bloom/dispatched_fast_multiblock64.hpp>
 
 #endif
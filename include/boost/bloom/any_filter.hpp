@@ -0,0 +1,540 @@
+/* Type-erased Bloom filter.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_ANY_FILTER_HPP
+#define BOOST_BLOOM_ANY_FILTER_HPP
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/bloom/dynamic_filter.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/config.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/core/span.hpp>
+#include <boost/core/typeinfo.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* any_filter<T> holds a filter behind the virtual interface
+ * any_filter_base<T>. Besides per-element operations, the interface has
+ * bulk entry points taking up to any_filter_chunk_size elements (passed as
+ * pointers) or any number of hash values, so that range operations pay for
+ * virtual dispatch once per chunk and still benefit from the pipelined
+ * bulk operations of the held filter.
+ */
+
+static constexpr std::size_t any_filter_chunk_size=1024;
+
+template<typename T>
+struct any_filter_base
+{
+  virtual ~any_filter_base()=default;
+
+  virtual std::unique_ptr<any_filter_base> clone()const=0;
+  virtual const boost::core::typeinfo& target_type()const noexcept=0;
+  virtual void* target()noexcept=0;
+
+  virtual std::size_t capacity()const noexcept=0;
+  virtual std::size_t estimated_size()const noexcept=0;
+  virtual double estimated_fpr()const noexcept=0;
+  virtual boost::span<unsigned char> array()noexcept=0;
+  virtual boost::span<const unsigned char> array()const noexcept=0;
+  virtual void clear()noexcept=0;
+
+  virtual std::uint64_t hash_for(const T& x)const=0;
+  virtual void insert(const T& x)=0;
+  virtual bool try_insert(const T& x)=0;
+  virtual void insert_hash(std::uint64_t hash)=0;
+  virtual bool try_insert_hash(std::uint64_t hash)=0;
+  virtual bool may_contain(const T& x)const=0;
+  virtual bool may_contain_hash(std::uint64_t hash)const=0;
+
+  /* n<=any_filter_chunk_size */
+  virtual void insert(const T* const* px,std::size_t n)=0;
+  virtual void may_contain(
+    const T* const* px,std::size_t n,bool* res)const=0;
+
+  virtual void insert_hash(const std::uint64_t* hashes,std::size_t n)=0;
+  virtual void may_contain_hash(
+    const std::uint64_t* hashes,std::size_t n,bool* res)const=0;
+  virtual std::size_t may_contain_bitmap(
+    boost::span<const T> x,std::uint64_t* bitmap)const=0;
+  virtual std::size_t may_contain_hash_bitmap(
+    boost::span<const std::uint64_t> hashes,std::uint64_t* bitmap)const=0;
+};
+
+template<typename T,typename Filter>
+struct any_filter_impl final:any_filter_base<T>
+{
+  using base=any_filter_base<T>;
+
+  template<typename F>
+  explicit any_filter_impl(F&& f_):f(std::forward<F>(f_)){}
+
+  std::unique_ptr<base> clone()const override
+  {
+    return std::unique_ptr<base>(new any_filter_impl(f));
+  }
+
+  const boost::core::typeinfo& target_type()const noexcept override
+  {
+    return BOOST_CORE_TYPEID(Filter);
+  }
+
+  void* target()noexcept override{return std::addressof(f);}
+
+  std::size_t capacity()const noexcept override{return f.capacity();}
+
+  std::size_t estimated_size()const noexcept override
+  {
+    return f.estimated_size();
+  }
+
+  double estimated_fpr()const noexcept override{return f.estimated_fpr();}
+
+  boost::span<unsigned char> array()noexcept override{return f.array();}
+
+  boost::span<const unsigned char> array()const noexcept override
+  {
+    return f.array();
+  }
+
+  void clear()noexcept override{f.clear();}
+
+  std::uint64_t hash_for(const T& x)const override{return f.hash_for(x);}
+  void insert(const T& x)override{f.insert(x);}
+  bool try_insert(const T& x)override{return f.try_insert(x);}
+  void insert_hash(std::uint64_t hash)override{f.insert_hash(hash);}
+
+  bool try_insert_hash(std::uint64_t hash)override
+  {
+    return f.try_insert_hash(hash);
+  }
+
+  bool may_contain(const T& x)const override{return f.may_contain(x);}
+
+  bool may_contain_hash(std::uint64_t hash)const override
+  {
+    return f.may_contain_hash(hash);
+  }
+
+  void insert(const T* const* px,std::size_t n)override
+  {
+    BOOST_ASSERT(n<=any_filter_chunk_size);
+    std::uint64_t hashes[any_filter_chunk_size];
+    for(std::size_t i=0;i<n;++i)hashes[i]=f.hash_for(*px[i]);
+    f.insert_hash(hashes,hashes+n);
+  }
+
+  void may_contain(const T* const* px,std::size_t n,bool* res)const override
+  {
+    BOOST_ASSERT(n<=any_filter_chunk_size);
+    std::uint64_t hashes[any_filter_chunk_size];
+    for(std::size_t i=0;i<n;++i)hashes[i]=f.hash_for(*px[i]);
+    may_contain_hash(hashes,n,res);
+  }
+
+  void insert_hash(const std::uint64_t* hashes,std::size_t n)override
+  {
+    f.insert_hash(hashes,hashes+n);
+  }
+
+  void may_contain_hash(
+    const std::uint64_t* hashes,std::size_t n,bool* res)const override
+  {
+    f.may_contain_hash(hashes,hashes+n,[&](std::uint64_t,bool b){
+      *res++=b;
+    });
+  }
+
+  std::size_t may_contain_bitmap(
+    boost::span<const T> x,std::uint64_t* bitmap)const override
+  {
+    return f.may_contain_bitmap(x,bitmap);
+  }
+
+  std::size_t may_contain_hash_bitmap(
+    boost::span<const std::uint64_t> hashes,
+    std::uint64_t* bitmap)const override
+  {
+    return f.may_contain_hash_bitmap(hashes,bitmap);
+  }
+
+  Filter f;
+};
+
+template<typename Filter,typename T>
+struct is_any_filter_target:std::false_type{};
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
+>
+struct is_any_filter_target<filter<T,K,SF,S,H,A>,T>:std::true_type{};
+
+template<typename T,typename SF,std::size_t S,typename H,typename A>
+struct is_any_filter_target<dynamic_filter<T,SF,S,H,A>,T>:std::true_type{};
+
+} /* namespace detail */
+
+template<typename T>
+class any_filter
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  using impl_base=detail::any_filter_base<T>;
+  template<typename Filter>
+  using enable_if_target_t=typename std::enable_if<
+    detail::is_any_filter_target<typename std::decay<Filter>::type,T>::value
+  >::type;
+
+public:
+  using value_type=T;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  using reference=value_type&;
+  using const_reference=const value_type&;
+  using pointer=value_type*;
+  using const_pointer=const value_type*;
+
+  any_filter()=default;
+
+  template<typename Filter,enable_if_target_t<Filter>* =nullptr>
+  any_filter(Filter&& f):
+    p{new detail::any_filter_impl<T,typename std::decay<Filter>::type>(
+      std::forward<Filter>(f))}{}
+
+  any_filter(const any_filter& x):p{x.p?x.p->clone():nullptr}{}
+  any_filter(any_filter&& x)noexcept=default;
+
+  any_filter& operator=(const any_filter& x)
+  {
+    if(this!=&x)p=x.p?x.p->clone():nullptr;
+    return *this;
+  }
+
+  any_filter& operator=(any_filter&& x)noexcept=default;
+
+  template<typename Filter,enable_if_target_t<Filter>* =nullptr>
+  any_filter& operator=(Filter&& f)
+  {
+    return *this=any_filter{std::forward<Filter>(f)};
+  }
+
+  explicit operator bool()const noexcept{return p!=nullptr;}
+
+  const boost::core::typeinfo& target_type()const noexcept
+  {
+    return p?p->target_type():BOOST_CORE_TYPEID(void);
+  }
+
+  template<typename Filter>
+  Filter* target()noexcept
+  {
+    return target_type()==BOOST_CORE_TYPEID(Filter)?
+      static_cast<Filter*>(p->target()):nullptr;
+  }
+
+  template<typename Filter>
+  const Filter* target()const noexcept
+  {
+    return const_cast<any_filter*>(this)->template target<Filter>();
+  }
+
+  std::size_t capacity()const noexcept{return get().capacity();}
+  boost::span<unsigned char> array()noexcept{return get().array();}
+
+  boost::span<const unsigned char> array()const noexcept
+  {
+    return get().array();
+  }
+
+  std::size_t estimated_size()const noexcept
+  {
+    return get().estimated_size();
+  }
+
+  double estimated_fpr()const noexcept{return get().estimated_fpr();}
+
+  void insert(const T& x){get().insert(x);}
+  bool try_insert(const T& x){return get().try_insert(x);}
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last)
+  {
+    insert_range(first,last,is_lvalue_range<InputIterator>{});
+  }
+
+  void insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(),il.end());
+  }
+
+  void insert_hash(std::uint64_t hash){get().insert_hash(hash);}
+  bool try_insert_hash(std::uint64_t hash){return get().try_insert_hash(hash);}
+
+  template<typename InputIterator>
+  void insert_hash(InputIterator first,InputIterator last)
+  {
+    std::uint64_t hashes[chunk_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(;n<chunk_size&&first!=last;++first)hashes[n++]=*first;
+      get().insert_hash(hashes,n);
+    }
+  }
+
+  void swap(any_filter& x)noexcept{std::swap(p,x.p);}
+  void clear()noexcept{get().clear();}
+
+  std::uint64_t hash_for(const T& x)const{return get().hash_for(x);}
+
+  bool may_contain(const T& x)const{return get().may_contain(x);}
+
+  template<typename InputIterator,typename F>
+  void may_contain(InputIterator first,InputIterator last,F f)const
+  {
+    may_contain_range(first,last,f,is_lvalue_range<InputIterator>{});
+  }
+
+  std::size_t may_contain_bitmap(
+    boost::span<const value_type> x,std::uint64_t* bitmap)const
+  {
+    return get().may_contain_bitmap(x,bitmap);
+  }
+
+  template<typename Index>
+  std::size_t may_contain_selection(
+    boost::span<const value_type> x,Index* selection)const
+  {
+    return may_contain_selection_impl(
+      x,selection,
+      [this](boost::span<const value_type> y,std::uint64_t* bitmap){
+        return get().may_contain_bitmap(y,bitmap);
+      });
+  }
+
+  bool may_contain_hash(std::uint64_t hash)const
+  {
+    return get().may_contain_hash(hash);
+  }
+
+  template<typename InputIterator,typename F>
+  void may_contain_hash(InputIterator first,InputIterator last,F f)const
+  {
+    std::uint64_t hashes[chunk_size];
+    bool          res[chunk_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(;n<chunk_size&&first!=last;++first)hashes[n++]=*first;
+      get().may_contain_hash(hashes,n,res);
+      for(std::size_t i=0;i<n;++i)f(hashes[i],res[i]);
+    }
+  }
+
+  std::size_t may_contain_hash_bitmap(
+    boost::span<const std::uint64_t> hashes,std::uint64_t* bitmap)const
+  {
+    return get().may_contain_hash_bitmap(hashes,bitmap);
+  }
+
+  template<typename Index>
+  std::size_t may_contain_hash_selection(
+    boost::span<const std::uint64_t> hashes,Index* selection)const
+  {
+    return may_contain_selection_impl(
+      hashes,selection,
+      [this](boost::span<const std::uint64_t> y,std::uint64_t* bitmap){
+        return get().may_contain_hash_bitmap(y,bitmap);
+      });
+  }
+
+private:
+  static constexpr std::size_t chunk_size=detail::any_filter_chunk_size;
+
+  /* Elements of forward ranges with lvalue references to T are passed by
+   * address chunk-wise to the held filter. For other ranges, elements are
+   * hashed as they are read and passed as hash chunks, except for lookup on
+   * single-pass ranges, which is done element by element so that f can be
+   * invoked while each element is still alive. Input iterators are not
+   * eligible for the address path even if their reference type is an
+   * lvalue, as it may refer to a value cached in the iterator itself (e.g.
+   * std::istream_iterator).
+   */
+
+  template<typename Iterator>
+  using is_lvalue_range=std::integral_constant<
+    bool,
+    std::is_base_of<
+      std::forward_iterator_tag,
+      typename std::iterator_traits<Iterator>::iterator_category>::value&&
+    std::is_lvalue_reference<
+      typename std::iterator_traits<Iterator>::reference>::value&&
+    std::is_same<
+      typename std::remove_cv<typename std::remove_reference<
+        typename std::iterator_traits<Iterator>::reference>::type>::type,
+      T
+    >::value
+  >;
+
+  impl_base& get()noexcept
+  {
+    BOOST_ASSERT(p);
+    return *p;
+  }
+
+  const impl_base& get()const noexcept
+  {
+    BOOST_ASSERT(p);
+    return *p;
+  }
+
+  template<typename InputIterator>
+  void insert_range(
+    InputIterator first,InputIterator last,std::true_type /* lvalues */)
+  {
+    const T* px[chunk_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(;n<chunk_size&&first!=last;++first)px[n++]=std::addressof(*first);
+      get().insert(px,n);
+    }
+  }
+
+  /* Elements not available as lvalues of type T are copied into buf,
+   * which is reused across chunks, so that their addresses can be passed
+   * to the bulk virtual functions as with lvalue ranges.
+   */
+
+  template<typename InputIterator>
+  static std::size_t materialize_chunk(
+    InputIterator& first,InputIterator last,std::vector<T>& buf,
+    const T** px)
+  {
+    buf.clear();
+    for(;buf.size()<chunk_size&&first!=last;++first)buf.push_back(*first);
+    for(std::size_t i=0;i<buf.size();++i)px[i]=std::addressof(buf[i]);
+    return buf.size();
+  }
+
+  template<typename InputIterator>
+  void insert_range(
+    InputIterator first,InputIterator last,std::false_type /* lvalues */)
+  {
+    std::vector<T> buf;
+    const T*       px[chunk_size];
+    while(first!=last){
+      get().insert(px,materialize_chunk(first,last,buf,px));
+    }
+  }
+
+  template<typename InputIterator,typename F>
+  void may_contain_range(
+    InputIterator first,InputIterator last,F& f,
+    std::true_type /* lvalues */)const
+  {
+    const T* px[chunk_size];
+    bool     res[chunk_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(;n<chunk_size&&first!=last;++first)px[n++]=std::addressof(*first);
+      get().may_contain(px,n,res);
+      for(std::size_t i=0;i<n;++i)f(*px[i],res[i]);
+    }
+  }
+
+  template<typename InputIterator,typename F>
+  void may_contain_range(
+    InputIterator first,InputIterator last,F& f,
+    std::false_type /* lvalues */)const
+  {
+    may_contain_range(
+      first,last,f,
+      typename std::iterator_traits<InputIterator>::iterator_category{});
+  }
+
+  template<typename InputIterator,typename F>
+  void may_contain_range(
+    InputIterator first,InputIterator last,F& f,
+    std::input_iterator_tag)const
+  {
+    /* elements can't be read again, so f is passed the copies */
+
+    std::vector<T> buf;
+    const T*       px[chunk_size];
+    bool           res[chunk_size];
+    while(first!=last){
+      auto n=materialize_chunk(first,last,buf,px);
+      get().may_contain(px,n,res);
+      for(std::size_t i=0;i<n;++i)f(buf[i],res[i]);
+    }
+  }
+
+  template<typename ForwardIterator,typename F>
+  void may_contain_range(
+    ForwardIterator first,ForwardIterator last,F& f,
+    std::forward_iterator_tag)const
+  {
+    std::vector<T> buf;
+    const T*       px[chunk_size];
+    bool           res[chunk_size];
+    while(first!=last){
+      auto it=first;
+      auto n=materialize_chunk(first,last,buf,px);
+      get().may_contain(px,n,res);
+      for(std::size_t i=0;i<n;++i,++it)f(*it,res[i]);
+    }
+  }
+
+  /* selection vectors are obtained from bitmaps calculated chunk-wise */
+
+  template<typename U,typename Index,typename BitmapFunction>
+  std::size_t may_contain_selection_impl(
+    boost::span<const U> x,Index* selection,BitmapFunction bf)const
+  {
+    static_assert(
+      std::is_integral<Index>::value,"Index must be an integral type");
+
+    std::uint64_t bitmap[chunk_size/64];
+    std::size_t   res=0;
+    for(std::size_t first=0;first<x.size();first+=chunk_size){
+      auto n=(std::min)(std::size_t(chunk_size),x.size()-first);
+      bf(x.subspan(first,n),bitmap);
+      for(std::size_t i=0;i<(n+63)/64;++i){
+        for(auto word=bitmap[i];word;word&=word-1){
+          selection[res++]=static_cast<Index>(
+            first+i*64+(std::size_t)boost::core::countr_zero(word));
+        }
+      }
+    }
+    return res;
+  }
+
+  std::unique_ptr<impl_base> p;
+};
+
+template<typename T>
+void swap(any_filter<T>& x,any_filter<T>& y)noexcept
+{
+  x.swap(y);
+}
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
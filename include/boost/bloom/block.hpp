@@ -12,6 +12,7 @@
 #include <boost/bloom/detail/block_base.hpp>
 #include <boost/bloom/detail/block_ops.hpp>
 #include <boost/bloom/detail/block_fpr_base.hpp>
+#include <boost/bloom/detail/extended_block_simd.hpp>
 #include <cstddef>
 #include <cstdint>
 
@@ -29,7 +30,7 @@ struct block:
   /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
   static inline void mark(value_type& x,std::uint64_t hash)
   {
-    loop(hash,[&](std::uint64_t h){block_ops::set(x,h&mask);});
+    mark(x,hash,simd_extended_block{});
   }
 
   /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
@@ -38,12 +39,45 @@ struct block:
     return check(x,hash,typename block_ops::is_extended_block{});
   }
 
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline bool try_mark(value_type& x,std::uint64_t hash)
+  {
+    return try_mark(x,hash,typename block_ops::is_extended_block{});
+  }
+
 private:
   using super=detail::block_base<Block,K>;
   using super::mask;
   using super::loop;
   using super::loop_while;
   using block_ops=detail::block_ops<Block>;
+  using simd_ops=detail::extended_block_simd<Block>;
+  using simd_extended_block=std::integral_constant<bool,simd_ops::enabled>;
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline void mark(
+    value_type& x,std::uint64_t hash,
+    std::false_type /* no SIMD extended block */)
+  {
+    loop(hash,[&](std::uint64_t h){block_ops::set(x,h&mask);});
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline void mark(
+    value_type& x,std::uint64_t hash,
+    std::true_type /* SIMD extended block */)
+  {
+    simd_ops::set_mask(x,fingerprint(hash));
+  }
+
+  template<typename SimdOps=simd_ops>
+  static BOOST_FORCEINLINE typename SimdOps::fingerprint_type
+  fingerprint(std::uint64_t hash)
+  {
+    auto fp=SimdOps::zero();
+    loop(hash,[&](std::uint64_t h){SimdOps::set(fp,h&mask);});
+    return fp;
+  }
 
   /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
   static inline bool check(
@@ -60,11 +94,72 @@ private:
   static inline bool check(
     const value_type& x,std::uint64_t hash,
     std::true_type /* extended block */)
+  {
+    return check_extended(x,hash,simd_extended_block{});
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline bool check_extended(
+    const value_type& x,std::uint64_t hash,
+    std::false_type /* no SIMD */)
   {
     return loop_while(hash,[&](std::uint64_t h){
       return block_ops::get_at_lsb(x,h&mask)&1;
     });
   }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline bool check_extended(
+    const value_type& x,std::uint64_t hash,
+    std::true_type /* SIMD */)
+  {
+    return simd_ops::testc(x,fingerprint(hash));
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline bool try_mark(
+    value_type& x,std::uint64_t hash,
+    std::false_type /* non-extended block */)
+  {
+    Block fp;
+    block_ops::zero(fp);
+    mark(fp,hash);
+    bool res=!block_ops::testc(x,fp);
+    block_ops::set_mask(x,fp);
+    return res;
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline bool try_mark(
+    value_type& x,std::uint64_t hash,
+    std::true_type /* extended block */)
+  {
+    return try_mark_extended(x,hash,simd_extended_block{});
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline bool try_mark_extended(
+    value_type& x,std::uint64_t hash,
+    std::false_type /* no SIMD */)
+  {
+    int res=0;
+    loop(hash,[&](std::uint64_t h){
+      res|=~block_ops::get_at_lsb(x,h&mask);
+      block_ops::set(x,h&mask);
+    });
+    return res&1;
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline bool try_mark_extended(
+    value_type& x,std::uint64_t hash,
+    std::true_type /* SIMD */)
+  {
+    auto fp=fingerprint(hash);
+    bool res=!simd_ops::testc(x,fp);
+    simd_ops::set_mask(x,fp);
+    return res;
+  }
 };
 
 } /* namespace bloom */
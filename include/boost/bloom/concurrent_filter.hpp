@@ -0,0 +1,161 @@
+/* Configurable Bloom filter supporting concurrent insertion and lookup.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_CONCURRENT_FILTER_HPP
+#define BOOST_BLOOM_CONCURRENT_FILTER_HPP
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/detail/atomic_subfilter.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+/* concurrent_filter has the same array layout and hash strategy as filter
+ * (for equal template arguments, both produce exactly the same array
+ * contents), but it marks bits with atomic operations. This is achieved by
+ * instantiating filter with an atomic adaptor of Subfilter (see
+ * detail/atomic_subfilter.hpp) and exposing only those operations that can
+ * be executed concurrently, plus construction, assignment and the like.
+ */
+
+template<
+  typename T,std::size_t K,
+  typename Subfilter=block<unsigned char,1>,std::size_t Stride=0,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>
+>
+class concurrent_filter:
+  private filter<
+    T,K,detail::atomic_subfilter<Subfilter,Stride>,Stride,Hash,Allocator
+  >
+{
+  using super=filter<
+    T,K,detail::atomic_subfilter<Subfilter,Stride>,Stride,Hash,Allocator>;
+
+public:
+  using value_type=typename super::value_type;
+  using super::k;
+  using subfilter=Subfilter;
+  using super::stride;
+  using super::bulk_insert_size;
+  using super::bulk_may_contain_size;
+  using hasher=typename super::hasher;
+  using allocator_type=typename super::allocator_type;
+  using size_type=typename super::size_type;
+  using difference_type=typename super::difference_type;
+  using reference=typename super::reference;
+  using const_reference=typename super::const_reference;
+  using pointer=typename super::pointer;
+  using const_pointer=typename super::const_pointer;
+
+  concurrent_filter()=default;
+  using super::super;
+  concurrent_filter(const concurrent_filter&)=default;
+  concurrent_filter(concurrent_filter&&)=default;
+
+  concurrent_filter(const concurrent_filter& x,const allocator_type& al):
+    super{x,al}{}
+
+  concurrent_filter(concurrent_filter&& x,const allocator_type& al):
+    super{std::move(x),al}{}
+
+  concurrent_filter& operator=(const concurrent_filter&)=default;
+
+  concurrent_filter& operator=(concurrent_filter&& x)
+    noexcept(noexcept(std::declval<super&>()=(std::declval<super&&>())))
+  {
+    super::operator=(std::move(x));
+    return *this;
+  }
+
+  concurrent_filter& operator=(std::initializer_list<value_type> il)
+  {
+    super::operator=(il);
+    return *this;
+  }
+
+  using super::get_allocator;
+  using super::capacity;
+  using super::capacity_for;
+  using super::fpr_for;
+  using super::array;
+
+  using super::insert;
+  using super::try_insert;
+  using super::insert_hash;
+  using super::try_insert_hash;
+
+  void swap(concurrent_filter& x)
+    noexcept(noexcept(std::declval<super&>().swap(std::declval<super&>())))
+  {
+    super::swap(x);
+  }
+
+  using super::clear;
+  using super::reset;
+
+  using super::hash_function;
+  using super::hash_for;
+
+  using super::may_contain;
+  using super::may_contain_bitmap;
+  using super::may_contain_selection;
+  using super::may_contain_hash;
+  using super::may_contain_hash_bitmap;
+  using super::may_contain_hash_selection;
+
+private:
+  template<
+    typename T1,std::size_t K1,typename SF,std::size_t S,typename H,typename A
+  >
+  bool friend operator==(
+    const concurrent_filter<T1,K1,SF,S,H,A>& x,
+    const concurrent_filter<T1,K1,SF,S,H,A>& y);
+};
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
+>
+bool operator==(
+  const concurrent_filter<T,K,SF,S,H,A>& x,
+  const concurrent_filter<T,K,SF,S,H,A>& y)
+{
+  using super=typename concurrent_filter<T,K,SF,S,H,A>::super;
+  return static_cast<const super&>(x)==static_cast<const super&>(y);
+}
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
+>
+bool operator!=(
+  const concurrent_filter<T,K,SF,S,H,A>& x,
+  const concurrent_filter<T,K,SF,S,H,A>& y)
+{
+  return !(x==y);
+}
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
+>
+void swap(
+  concurrent_filter<T,K,SF,S,H,A>& x,concurrent_filter<T,K,SF,S,H,A>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
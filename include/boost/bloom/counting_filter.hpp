@@ -0,0 +1,640 @@
+/* Counting Bloom filter supporting deletion.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_COUNTING_FILTER_HPP
+#define BOOST_BLOOM_COUNTING_FILTER_HPP
+
+#include <boost/assert.hpp>
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/counter_ops.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/config.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/container_hash/hash_is_avalanching.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/core/span.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* counting_filter replaces each bit of the array of
+ * filter<T,K,Subfilter,Stride,Hash,Allocator> with a saturating counter of
+ * CounterBits (4 or 8) bits, so that elements can be erased. Block selection
+ * and hash mixing are those of filter, and each subfilter operation updates
+ * the counters of the bits Subfilter::mark would set on the selected block,
+ * which are laid out contiguously: for instance, the 64 bits of a
+ * block<std::uint64_t,K> map to 32 bytes of 4-bit counters. A counter is
+ * nonzero iff the corresponding bit of the equivalent filter is set, hence
+ * to_filter() produces exactly the filter that would result from inserting
+ * the elements not erased, as long as no counter has saturated.
+ */
+
+template<
+  typename T,std::size_t K,
+  typename Subfilter=block<unsigned char,1>,std::size_t Stride=0,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>,
+  std::size_t CounterBits=4
+>
+class
+
+#if defined(_MSC_VER)&&_MSC_FULL_VER>=190023918
+__declspec(empty_bases) /* activate EBO with multiple inheritance */
+#endif
+
+counting_filter:
+  empty_value<Hash,0>,
+  empty_value<Allocator,1>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+  static_assert(K>0,"K must be >= 1");
+
+  using hash_base=empty_value<Hash,0>;
+  using allocator_base=empty_value<Allocator,1>;
+  using ops=detail::counter_ops<CounterBits>;
+  using mix_policy=typename std::conditional<
+    boost::hash_is_avalanching<Hash>::value&&
+    sizeof(std::size_t)>=sizeof(std::uint64_t),
+    detail::no_mix_policy,
+    detail::mulx64_mix_policy
+  >::type;
+  using hash_strategy=detail::fastrange_and_mcg;
+  using layout=detail::block_layout<Subfilter,Stride>;
+  using block_type=typename layout::block_type;
+  static constexpr std::size_t used_value_size=layout::used_value_size;
+  static constexpr std::size_t cacheline=layout::cacheline;
+
+  /* the counters of a block take counter_bits times its size */
+
+  static constexpr std::size_t prefetched_cachelines=
+    1+(used_value_size*CounterBits+cacheline-1-
+       detail::gcd_pow2(layout::stride*CounterBits,cacheline))/cacheline;
+
+  /* as in filter, a dummy array of saturated counters serves lookups on
+   * zero capacity and moved-from counting filters
+   */
+
+  using array_allocator=detail::aligned_array<
+    cacheline,used_value_size*CounterBits,(unsigned char)-1>;
+  static constexpr std::size_t bulk_insert_size=
+    (BOOST_BLOOM_BULK_PREFETCHED_CACHELINES+prefetched_cachelines-1)/
+    prefetched_cachelines;
+
+public:
+  using filter_type=filter<T,K,Subfilter,Stride,Hash,Allocator>;
+  using value_type=T;
+  static constexpr std::size_t k=K;
+  using subfilter=Subfilter;
+  static constexpr std::size_t stride=filter_type::stride;
+  static constexpr std::size_t counter_bits=CounterBits;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  using reference=value_type&;
+  using const_reference=const value_type&;
+  using pointer=value_type*;
+  using const_pointer=const value_type*;
+
+  explicit counting_filter(
+    std::size_t m=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    hash_base{empty_init,h},allocator_base{empty_init,al},
+    hs{requested_range(m)},
+    counters{new_array(this->al(),m?hs.range():0)}
+  {
+    clear();
+  }
+
+  counting_filter(
+    std::size_t n,double fpr,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    counting_filter{capacity_for(n,fpr),h,al}{}
+
+  counting_filter(std::size_t m,const allocator_type& al):
+    counting_filter{m,hasher(),al}{}
+
+  counting_filter(std::size_t n,double fpr,const allocator_type& al):
+    counting_filter{n,fpr,hasher(),al}{}
+
+  counting_filter(const counting_filter& x):
+    counting_filter{
+      x,allocator_select_on_container_copy_construction(x.al())}{}
+
+  counting_filter(counting_filter&& x)noexcept:
+    hash_base{empty_init,std::move(x.h())},
+    allocator_base{empty_init,std::move(x.al())},
+    hs{x.hs},
+    counters{x.counters}
+  {
+    x.hs=hash_strategy{0};
+    x.counters=new_array(x.al(),0);
+  }
+
+  counting_filter(const counting_filter& x,const allocator_type& al):
+    hash_base{empty_init,x.h()},allocator_base{empty_init,al},
+    hs{x.hs},
+    counters{new_array(this->al(),x.range())}
+  {
+    std::memcpy(counters.array,x.counters.array,used_counters_size());
+  }
+
+  ~counting_filter()noexcept
+  {
+    delete_array();
+  }
+
+  counting_filter& operator=(const counting_filter& x)
+  {
+    static constexpr auto pocca=
+      allocator_propagate_on_container_copy_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      counting_filter tmp{x,pocca?x.al():al()};
+      swap_all(tmp);
+    }
+    return *this;
+  }
+
+  counting_filter& operator=(counting_filter&& x)
+  {
+    static constexpr auto pocma=
+      allocator_propagate_on_container_move_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      if(pocma||al()==x.al()){
+        counting_filter tmp{std::move(x)};
+        swap_all(tmp);
+      }
+      else{
+        counting_filter tmp{x,al()};
+        swap_all(tmp);
+        x.reset();
+      }
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator()const noexcept
+  {
+    return al();
+  }
+
+  /* number of counters, which is the capacity of the projected filter */
+
+  std::size_t capacity()const noexcept
+  {
+    return used_array_size(range())*CHAR_BIT;
+  }
+
+  static std::size_t capacity_for(std::size_t n,double fpr)
+  {
+    return filter_type::capacity_for(n,fpr);
+  }
+
+  static double fpr_for(std::size_t n,std::size_t m)
+  {
+    return filter_type::fpr_for(n,m);
+  }
+
+  boost::span<unsigned char> array()noexcept
+  {
+    return {counters.data?counters.array:nullptr,used_counters_size()};
+  }
+
+  boost::span<const unsigned char> array()const noexcept
+  {
+    return {counters.data?counters.array:nullptr,used_counters_size()};
+  }
+
+  BOOST_FORCEINLINE void insert(const T& x)
+  {
+    insert_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE void insert(const U& x)
+  {
+    insert_hash(hash_for(x));
+  }
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last)
+  {
+    update_range(
+      first,last,increment{},
+      typename std::iterator_traits<InputIterator>::iterator_category{});
+  }
+
+  void insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(),il.end());
+  }
+
+  BOOST_FORCEINLINE void insert_hash(std::uint64_t hash)
+  {
+    if(!counters.data)return;
+    for_each_position(hash,increment{});
+  }
+
+  /* Erasing an element that was not inserted can make lookups for other
+   * elements return false negatives.
+   */
+
+  BOOST_FORCEINLINE void erase(const T& x)
+  {
+    erase_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE void erase(const U& x)
+  {
+    erase_hash(hash_for(x));
+  }
+
+  template<typename InputIterator>
+  void erase(InputIterator first,InputIterator last)
+  {
+    update_range(
+      first,last,decrement{},
+      typename std::iterator_traits<InputIterator>::iterator_category{});
+  }
+
+  void erase(std::initializer_list<value_type> il)
+  {
+    erase(il.begin(),il.end());
+  }
+
+  BOOST_FORCEINLINE void erase_hash(std::uint64_t hash)
+  {
+    if(!counters.data)return;
+    for_each_position(hash,decrement{});
+  }
+
+  void swap(counting_filter& x)noexcept(
+    allocator_propagate_on_container_swap_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_NOTHROW_SWAPPABLE(Hash);
+    static constexpr auto pocs=
+      allocator_propagate_on_container_swap_t<allocator_type>::value;
+
+    using std::swap;
+    if(pocs)swap(al(),x.al());
+    else BOOST_ASSERT(al()==x.al());
+    swap(h(),x.h());
+    std::swap(hs,x.hs);
+    std::swap(counters,x.counters);
+  }
+
+  void clear()noexcept
+  {
+    std::memset(counters.array,0,used_counters_size());
+  }
+
+  void reset(std::size_t m=0)
+  {
+    hash_strategy new_hs{requested_range(m)};
+    std::size_t   rng=m?new_hs.range():0;
+    if(rng!=range()){
+      auto new_counters=new_array(al(),rng);
+      delete_array();
+      hs=hash_strategy{rng};
+      counters=new_counters;
+    }
+    clear();
+  }
+
+  void reset(std::size_t n,double fpr)
+  {
+    reset(capacity_for(n,fpr));
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const T& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  BOOST_FORCEINLINE bool may_contain(const T& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  BOOST_FORCEINLINE bool may_contain_hash(std::uint64_t hash)const
+  {
+    hs.prepare_hash(hash);
+    for(auto n=k;n--;){
+      unsigned char m[used_value_size];
+      auto          p=next_counters(hash,m);
+      if(!ops::template check<used_value_size>(p,m))return false;
+    }
+    return true;
+  }
+
+  /* Filter with bits set where counters are nonzero. Its array is written
+   * directly, which is much faster than reinserting the elements, and its
+   * capacity is that of *this.
+   */
+
+  filter_type to_filter()const
+  {
+    filter_type f{capacity(),h(),al()};
+    BOOST_ASSERT(f.capacity()==capacity());
+    auto a=f.array();
+    for(std::size_t i=0;i<a.size();++i){
+      a[i]=ops::project(counters.array+i*counter_bits);
+    }
+    return f;
+  }
+
+  friend bool operator==(const counting_filter& x,const counting_filter& y)
+  {
+    if(x.range()!=y.range())return false;
+    else if(!x.range())return true;
+    else return std::memcmp(
+      x.counters.array,y.counters.array,x.used_counters_size())==0;
+  }
+
+private:
+  using counter_array=detail::filter_array;
+
+  const Hash& h()const{return hash_base::get();}
+  Hash& h(){return hash_base::get();}
+  const Allocator& al()const{return allocator_base::get();}
+  Allocator& al(){return allocator_base::get();}
+
+  /* same range as filter_type for equal m */
+
+  static std::size_t requested_range(std::size_t m)
+  {
+    return layout::requested_range(m);
+  }
+
+  std::size_t range()const noexcept
+  {
+    return hs.range();
+  }
+
+  static std::size_t used_array_size(std::size_t rng)noexcept
+  {
+    return layout::used_array_size(rng);
+  }
+
+  std::size_t used_counters_size()const noexcept
+  {
+    return used_array_size(range())*counter_bits;
+  }
+
+  static std::size_t space_for(std::size_t rng)noexcept
+  {
+    return used_array_size(rng)*counter_bits;
+  }
+
+  static counter_array new_array(allocator_type& al_,std::size_t rng)
+  {
+    return rng?
+      array_allocator::allocate(al_,space_for(rng)):
+      array_allocator::dummy();
+  }
+
+  void delete_array()noexcept
+  {
+    array_allocator::deallocate(al(),counters,space_for(range()));
+  }
+
+  void swap_all(counting_filter& x)noexcept
+  {
+    using std::swap;
+    swap(al(),x.al());
+    swap(h(),x.h());
+    std::swap(hs,x.hs);
+    std::swap(counters,x.counters);
+  }
+
+  struct increment
+  {
+    BOOST_FORCEINLINE void operator()(
+      unsigned char* p,const unsigned char* m)const
+    {
+      ops::template increment<used_value_size>(p,m);
+    }
+  };
+
+  struct decrement
+  {
+    BOOST_FORCEINLINE void operator()(
+      unsigned char* p,const unsigned char* m)const
+    {
+      ops::template decrement<used_value_size>(p,m);
+    }
+  };
+
+  /* Selects the next block as filter does and returns a pointer to its
+   * counters, along with the bits Subfilter::mark would set on the block.
+   */
+
+  BOOST_FORCEINLINE unsigned char* next_counters(
+    std::uint64_t& hash,unsigned char* m)noexcept
+  {
+    auto p=counters.array+hs.next_position(hash)*stride*counter_bits;
+    for(std::size_t i=0;i<prefetched_cachelines;++i){
+      BOOST_BLOOM_PREFETCH_WRITE(p+i*cacheline);
+    }
+    mask_for(hash,m);
+    return p;
+  }
+
+  BOOST_FORCEINLINE const unsigned char* next_counters(
+    std::uint64_t& hash,unsigned char* m)const noexcept
+  {
+    auto p=counters.array+hs.next_position(hash)*stride*counter_bits;
+    BOOST_BLOOM_PREFETCH(p);
+    mask_for(hash,m);
+    return p;
+  }
+
+  static BOOST_FORCEINLINE void mask_for(
+    std::uint64_t hash,unsigned char* m)
+  {
+    block_type x;
+    std::memset(&x,0,sizeof(x));
+    subfilter::mark(x,hash);
+    std::memcpy(m,&x,used_value_size);
+  }
+
+  template<typename F>
+  BOOST_FORCEINLINE void for_each_position(std::uint64_t hash,F f)
+  {
+    hs.prepare_hash(hash);
+    for(auto n=k;n--;){
+      unsigned char m[used_value_size];
+      auto          p=next_counters(hash,m);
+      f(p,m);
+    }
+  }
+
+  template<typename InputIterator,typename F>
+  void update_range(
+    InputIterator first,InputIterator last,F f,std::input_iterator_tag)
+  {
+    if(!counters.data)return;
+    for(;first!=last;++first)for_each_position(hash_for(*first),f);
+  }
+
+  template<typename ForwardIterator,typename F>
+  void update_range(
+    ForwardIterator first,ForwardIterator last,F f,
+    std::forward_iterator_tag)
+  {
+    auto n=static_cast<std::size_t>(std::distance(first,last));
+    bulk_update([&]{return hash_for(*first++);},n,f);
+  }
+
+  /* Same pipelining scheme as filter's bulk insertion: counters for the
+   * next bulk_insert_size elements are prefetched before being updated,
+   * round by round, with the last round for a window interleaved with the
+   * first round for the next one.
+   */
+
+  template<typename HashStream,typename F>
+  void bulk_update(HashStream h_,std::size_t n,F f)
+  {
+    if(BOOST_UNLIKELY(counters.data==nullptr))return;
+
+    std::uint64_t  hashes[bulk_insert_size];
+    unsigned char* positions[bulk_insert_size];
+    unsigned char  masks[bulk_insert_size][used_value_size];
+
+    if(n>=bulk_insert_size){
+      for(std::size_t i=0;i<bulk_insert_size;++i){
+        hashes[i]=h_();
+        hs.prepare_hash(hashes[i]);
+        positions[i]=next_counters(hashes[i],masks[i]);
+      }
+      n-=bulk_insert_size;
+      for(;;){
+        for(std::size_t j=k-1;j--;){
+          for(std::size_t i=0;i<bulk_insert_size;++i){
+            f(positions[i],masks[i]);
+            positions[i]=next_counters(hashes[i],masks[i]);
+          }
+        }
+        if(n<bulk_insert_size)break;
+        for(std::size_t i=0;i<bulk_insert_size;++i){
+          f(positions[i],masks[i]);
+          hashes[i]=h_();
+          hs.prepare_hash(hashes[i]);
+          positions[i]=next_counters(hashes[i],masks[i]);
+        }
+        n-=bulk_insert_size;
+      }
+      for(std::size_t i=0;i<bulk_insert_size;++i){
+        f(positions[i],masks[i]);
+      }
+    }
+
+    for(std::size_t i=0;i<n;++i){
+      hashes[i]=h_();
+      hs.prepare_hash(hashes[i]);
+      positions[i]=next_counters(hashes[i],masks[i]);
+    }
+    for(std::size_t j=k;j--;){
+      for(std::size_t i=0;i<n;++i){
+        f(positions[i],masks[i]);
+        if(j)positions[i]=next_counters(hashes[i],masks[i]);
+      }
+    }
+  }
+
+  hash_strategy hs;
+  counter_array counters;
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A,
+  std::size_t CB
+>
+bool operator!=(
+  const counting_filter<T,K,SF,S,H,A,CB>& x,
+  const counting_filter<T,K,SF,S,H,A,CB>& y)
+{
+  return !(x==y);
+}
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A,
+  std::size_t CB
+>
+void swap(
+  counting_filter<T,K,SF,S,H,A,CB>& x,counting_filter<T,K,SF,S,H,A,CB>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
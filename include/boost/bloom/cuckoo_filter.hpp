@@ -0,0 +1,649 @@
+/* Cuckoo filter.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_CUCKOO_FILTER_HPP
+#define BOOST_BLOOM_CUCKOO_FILTER_HPP
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/cuckoo_buckets.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/config.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/container_hash/hash_is_avalanching.hpp>
+#include <boost/core/allocator_traits.hpp>
+#include <boost/core/empty_value.hpp>
+#include <boost/core/span.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Cuckoo filter after Fan et al. 2014 https://doi.org/10.1145/2674005.2674994
+ * with partial-key cuckoo hashing: an element is stored as a fingerprint of
+ * FingerprintBits bits in one of two buckets i1 and i2 of BucketSize slots.
+ * i1 is obtained from the element's hash with fastrange (as positions in
+ * filter are) and i2=(h(fp)-i1) mod m, which, unlike the original
+ * i1 xor h(fp), doesn't require the number of buckets m to be a power of
+ * two and still allows to go from one bucket to the other without knowing
+ * the element. When both buckets are full, the element displaces a random
+ * fingerprint in one of them, which is relocated to its alternate bucket,
+ * and so on up to max_kicks times. If no room is found, displacements are
+ * undone in reverse order and insertion fails, so a failed insertion
+ * leaves the filter unchanged.
+ */
+
+template<
+  typename T,std::size_t FingerprintBits,std::size_t BucketSize=4,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>
+>
+class
+
+#if defined(_MSC_VER)&&_MSC_FULL_VER>=190023918
+__declspec(empty_bases) /* activate EBO with multiple inheritance */
+#endif
+
+cuckoo_filter:
+  empty_value<Hash,0>,
+  empty_value<Allocator,1>
+{
+  BOOST_BLOOM_STATIC_ASSERT_IS_CV_UNQUALIFIED_OBJECT(T);
+  static_assert(
+    std::is_same<unsigned char,allocator_value_type_t<Allocator>>::value,
+    "Allocator's value_type must be unsigned char");
+
+  using hash_base=empty_value<Hash,0>;
+  using allocator_base=empty_value<Allocator,1>;
+  using buckets=detail::cuckoo_buckets<FingerprintBits,BucketSize>;
+  using mix_policy=typename std::conditional<
+    boost::hash_is_avalanching<Hash>::value&&
+    sizeof(std::size_t)>=sizeof(std::uint64_t),
+    detail::no_mix_policy,
+    detail::mulx64_mix_policy
+  >::type;
+
+public:
+  using value_type=T;
+  static constexpr std::size_t fingerprint_bits=FingerprintBits;
+  static constexpr std::size_t bucket_size=BucketSize;
+  static constexpr std::size_t max_kicks=500;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  using reference=value_type&;
+  using const_reference=const value_type&;
+  using pointer=value_type*;
+  using const_pointer=const value_type*;
+
+  explicit cuckoo_filter(
+    std::size_t m=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    hash_base{empty_init,h},allocator_base{empty_init,al},
+    rng{num_buckets_for(m)},
+    ar{new_array(this->al(),rng)}
+  {
+    clear();
+  }
+
+  cuckoo_filter(
+    std::size_t n,double fpr,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    cuckoo_filter{capacity_for(n,fpr),h,al}{}
+
+  cuckoo_filter(std::size_t m,const allocator_type& al):
+    cuckoo_filter{m,hasher(),al}{}
+
+  cuckoo_filter(std::size_t n,double fpr,const allocator_type& al):
+    cuckoo_filter{n,fpr,hasher(),al}{}
+
+  cuckoo_filter(const cuckoo_filter& x):
+    cuckoo_filter{
+      x,allocator_select_on_container_copy_construction(x.al())}{}
+
+  cuckoo_filter(cuckoo_filter&& x)noexcept:
+    hash_base{empty_init,std::move(x.h())},
+    allocator_base{empty_init,std::move(x.al())},
+    rng{x.rng},size_{x.size_},ar{x.ar}
+  {
+    x.rng=0;
+    x.size_=0;
+    x.ar=new_array(x.al(),0);
+  }
+
+  cuckoo_filter(const cuckoo_filter& x,const allocator_type& al):
+    hash_base{empty_init,x.h()},allocator_base{empty_init,al},
+    rng{x.rng},size_{x.size_},
+    ar{new_array(this->al(),x.rng)}
+  {
+    std::memcpy(ar.array,x.ar.array,space_used());
+  }
+
+  ~cuckoo_filter()noexcept
+  {
+    delete_array();
+  }
+
+  cuckoo_filter& operator=(const cuckoo_filter& x)
+  {
+    static constexpr auto pocca=
+      allocator_propagate_on_container_copy_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      cuckoo_filter tmp{x,pocca?x.al():al()};
+      swap_all(tmp);
+    }
+    return *this;
+  }
+
+  cuckoo_filter& operator=(cuckoo_filter&& x)
+  {
+    static constexpr auto pocma=
+      allocator_propagate_on_container_move_assignment_t<allocator_type>::
+        value;
+
+    if(this!=&x){
+      if(pocma||al()==x.al()){
+        cuckoo_filter tmp{std::move(x)};
+        swap_all(tmp);
+      }
+      else{
+        cuckoo_filter tmp{x,al()};
+        swap_all(tmp);
+        x.reset();
+      }
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator()const noexcept
+  {
+    return al();
+  }
+
+  /* size of the array in bits */
+
+  std::size_t capacity()const noexcept
+  {
+    return rng*buckets::bucket_bits;
+  }
+
+  static std::size_t capacity_for(std::size_t n,double fpr)
+  {
+    BOOST_ASSERT(fpr>=0.0&&fpr<=1.0);
+    if(n==0)return fpr==1.0?0:buckets::bucket_bits;
+
+    /* number of slots so as not to exceed the maximum load factor and
+     * to have a load factor low enough for fpr (see fpr_for)
+     */
+
+    const double max_slots=
+      (double)((std::numeric_limits<std::size_t>::max)()/
+               buckets::bucket_bits/BucketSize)*BucketSize;
+    double       slots=n/max_load_factor();
+    if(fpr<1.0){
+      double l=std::log1p(-fingerprint_match_probability());
+      double d=std::log1p(-fpr);
+      if(std::fpclassify(d)==FP_ZERO)slots=max_slots; /* fpr ~ 0 */
+      else slots=(std::max)(slots,2.0*BucketSize*n*l/d);
+    }
+    slots=(std::min)(slots,max_slots);
+    return
+      (std::size_t)std::ceil(slots/BucketSize)*buckets::bucket_bits;
+  }
+
+  /* A lookup compares the fingerprint of the element with the 2*BucketSize
+   * slots of its buckets, each occupied with probability equal to the load
+   * factor, and fingerprints are uniformly distributed among the 2^f-1
+   * nonzero values.
+   */
+
+  static double fpr_for(std::size_t n,std::size_t m)
+  {
+    std::size_t slots=num_buckets_for(m)*BucketSize;
+    if(slots==0)return n==0?0.0:1.0;
+    double load=(std::min)((double)n/slots,1.0);
+    return -std::expm1(
+      2.0*BucketSize*load*std::log1p(-fingerprint_match_probability()));
+  }
+
+  /* Load factor beyond which insertions are likely to fail, as determined
+   * experimentally in the literature.
+   */
+
+  static constexpr double max_load_factor()noexcept
+  {
+    return BucketSize==1?0.5:
+           BucketSize==2?0.84:
+           BucketSize<8? 0.95:
+                         0.98;
+  }
+
+  /* number of fingerprints stored */
+
+  std::size_t size()const noexcept
+  {
+    return size_;
+  }
+
+  double load_factor()const noexcept
+  {
+    return rng?(double)size_/(rng*BucketSize):0.0;
+  }
+
+  boost::span<const unsigned char> array()const noexcept
+  {
+    return {ar.data?ar.array:nullptr,buckets::used_array_size(rng)};
+  }
+
+  BOOST_FORCEINLINE bool insert(const T& x)
+  {
+    return insert_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool insert(const U& x)
+  {
+    return insert_hash(hash_for(x));
+  }
+
+  /* stops at the first element that can't be inserted */
+
+  template<typename InputIterator>
+  bool insert(InputIterator first,InputIterator last)
+  {
+    for(;first!=last;++first)if(!insert(*first))return false;
+    return true;
+  }
+
+  bool insert(std::initializer_list<value_type> il)
+  {
+    return insert(il.begin(),il.end());
+  }
+
+  bool insert_hash(std::uint64_t hash)
+  {
+    if(!rng)return false;
+
+    auto fp=fingerprint(hash);
+    auto i=index(hash);
+    if(try_put(i,fp))return true;
+    i=alt_index(i,fp);
+    if(try_put(i,fp))return true;
+
+    std::size_t path[max_kicks];
+    std::size_t n=0;
+    hash|=1u; /* see detail::fastrange_and_mcg */
+    for(;n<max_kicks;++n){
+      /* displace a random slot */
+
+      hash*=detail::fastrange_and_mcg::multiplier;
+      auto j=fastrange(hash,BucketSize);
+      auto victim=buckets::get(ar.array,i,j);
+      buckets::set(ar.array,i,j,fp);
+      path[n]=i*BucketSize+j;
+      fp=victim;
+      i=alt_index(i,fp);
+      if(try_put(i,fp))return true;
+    }
+
+    /* undo displacements */
+
+    while(n--){
+      auto i_=path[n]/BucketSize,j=path[n]%BucketSize;
+      auto victim=buckets::get(ar.array,i_,j);
+      buckets::set(ar.array,i_,j,fp);
+      fp=victim;
+    }
+    return false;
+  }
+
+  /* Erasing an element that was not inserted can remove a matching
+   * fingerprint of another element, which then yields false negatives.
+   */
+
+  BOOST_FORCEINLINE bool erase(const T& x)
+  {
+    return erase_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool erase(const U& x)
+  {
+    return erase_hash(hash_for(x));
+  }
+
+  template<typename InputIterator>
+  std::size_t erase(InputIterator first,InputIterator last)
+  {
+    std::size_t res=0;
+    for(;first!=last;++first)res+=erase(*first);
+    return res;
+  }
+
+  std::size_t erase(std::initializer_list<value_type> il)
+  {
+    return erase(il.begin(),il.end());
+  }
+
+  bool erase_hash(std::uint64_t hash)
+  {
+    auto fp=fingerprint(hash);
+    auto i1=index(hash);
+    auto i2=alt_index(i1,fp);
+    if(try_remove(i1,fp)||try_remove(i2,fp))return true;
+    return false;
+  }
+
+  void swap(cuckoo_filter& x)noexcept(
+    allocator_propagate_on_container_swap_t<allocator_type>::value||
+    allocator_is_always_equal_t<allocator_type>::value)
+  {
+    BOOST_BLOOM_STATIC_ASSERT_IS_NOTHROW_SWAPPABLE(Hash);
+    static constexpr auto pocs=
+      allocator_propagate_on_container_swap_t<allocator_type>::value;
+
+    using std::swap;
+    if(pocs)swap(al(),x.al());
+    else BOOST_ASSERT(al()==x.al());
+    swap(h(),x.h());
+    std::swap(rng,x.rng);
+    std::swap(size_,x.size_);
+    std::swap(ar,x.ar);
+  }
+
+  void clear()noexcept
+  {
+    std::memset(ar.array,0,space_used());
+    size_=0;
+  }
+
+  void reset(std::size_t m=0)
+  {
+    std::size_t new_rng=num_buckets_for(m);
+    if(new_rng!=rng){
+      auto new_ar=new_array(al(),new_rng);
+      delete_array();
+      rng=new_rng;
+      ar=new_ar;
+    }
+    clear();
+  }
+
+  void reset(std::size_t n,double fpr)
+  {
+    reset(capacity_for(n,fpr));
+  }
+
+  hasher hash_function()const
+  {
+    return h();
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const T& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  BOOST_FORCEINLINE bool may_contain(const T& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    return may_contain_hash(hash_for(x));
+  }
+
+  static constexpr std::size_t bulk_may_contain_size=16;
+
+  template<typename InputIterator,typename F>
+  void may_contain(InputIterator first,InputIterator last,F f)const
+  {
+    may_contain_range(
+      first,last,f,
+      typename std::iterator_traits<InputIterator>::iterator_category{});
+  }
+
+  BOOST_FORCEINLINE bool may_contain_hash(std::uint64_t hash)const
+  {
+    auto fp=fingerprint(hash);
+    auto i1=index(hash);
+    return buckets::contains(ar.array,i1,alt_index(i1,fp),fp);
+  }
+
+  friend bool operator==(const cuckoo_filter& x,const cuckoo_filter& y)
+  {
+    if(x.rng!=y.rng)return false;
+    else return std::memcmp(x.ar.array,y.ar.array,x.space_used())==0;
+  }
+
+private:
+  using bucket_array=detail::filter_array;
+
+  /* zero capacity and moved-from cuckoo filters point to a statically
+   * allocated dummy array with one empty bucket for read operations
+   */
+
+  using array_allocator=detail::aligned_array<
+    64,buckets::used_array_size(1)+buckets::tail_size,0>;
+
+  const Hash& h()const{return hash_base::get();}
+  Hash& h(){return hash_base::get();}
+  const Allocator& al()const{return allocator_base::get();}
+  Allocator& al(){return allocator_base::get();}
+
+  static constexpr double fingerprint_match_probability()noexcept
+  {
+    return 1.0/(double)buckets::fingerprint_mask;
+  }
+
+  static std::size_t num_buckets_for(std::size_t m)noexcept
+  {
+    return m/buckets::bucket_bits+(m%buckets::bucket_bits!=0);
+  }
+
+  static BOOST_FORCEINLINE std::size_t fastrange(
+    std::uint64_t hash,std::size_t rng_)noexcept
+  {
+    boost::uint64_t hi;
+    detail::umul128(hash,rng_,hi);
+    return (std::size_t)hi;
+  }
+
+  /* nonzero fingerprint from the low bits of hash */
+
+  static BOOST_FORCEINLINE std::uint64_t fingerprint(
+    std::uint64_t hash)noexcept
+  {
+    std::uint64_t fp=hash&buckets::fingerprint_mask;
+    return fp+(fp==0);
+  }
+
+  BOOST_FORCEINLINE std::size_t index(std::uint64_t hash)const noexcept
+  {
+    return fastrange(hash,rng);
+  }
+
+  BOOST_FORCEINLINE std::size_t alt_index(
+    std::size_t i,std::uint64_t fp)const noexcept
+  {
+    auto hfp=fastrange(fp*0x9E3779B97F4A7C15ull,rng);
+    return hfp>=i?hfp-i:hfp+rng-i;
+  }
+
+  BOOST_FORCEINLINE void prefetch(std::size_t i)const noexcept
+  {
+    BOOST_BLOOM_PREFETCH(ar.array+i*buckets::bucket_bits/8);
+  }
+
+  template<typename InputIterator,typename F>
+  void may_contain_range(
+    InputIterator first,InputIterator last,F& f,
+    std::input_iterator_tag)const
+  {
+    for(;first!=last;++first){
+      const auto& x=*first;
+      f(x,may_contain(x));
+    }
+  }
+
+  /* Buckets for the next bulk_may_contain_size elements are prefetched
+   * before probing, so that memory accesses overlap.
+   */
+
+  template<typename ForwardIterator,typename F>
+  void may_contain_range(
+    ForwardIterator first,ForwardIterator last,F& f,
+    std::forward_iterator_tag)const
+  {
+    static constexpr std::size_t n=bulk_may_contain_size;
+
+    std::uint64_t fps[n];
+    std::size_t   is[n][2];
+    while(first!=last){
+      auto        it=first;
+      std::size_t m=0;
+      for(;m<n&&it!=last;++m,++it){
+        auto hash=hash_for(*it);
+        fps[m]=fingerprint(hash);
+        is[m][0]=index(hash);
+        is[m][1]=alt_index(is[m][0],fps[m]);
+        prefetch(is[m][0]);
+        prefetch(is[m][1]);
+      }
+      for(std::size_t j=0;j<m;++j,++first){
+        f(*first,buckets::contains(ar.array,is[j][0],is[j][1],fps[j]));
+      }
+    }
+  }
+
+  bool try_put(std::size_t i,std::uint64_t fp)noexcept
+  {
+    auto j=buckets::find(ar.array,i,0);
+    if(j==BucketSize)return false;
+    buckets::set(ar.array,i,j,fp);
+    ++size_;
+    return true;
+  }
+
+  bool try_remove(std::size_t i,std::uint64_t fp)noexcept
+  {
+    auto j=buckets::find(ar.array,i,fp);
+    if(j==BucketSize)return false;
+    buckets::set(ar.array,i,j,0);
+    --size_;
+    return true;
+  }
+
+  /* bytes of the array, including tail padding (none if rng==0, so that
+   * clear() and copy construction never write to the dummy array)
+   */
+
+  std::size_t space_used()const noexcept
+  {
+    return space_for(rng);
+  }
+
+  static std::size_t space_for(std::size_t rng_)noexcept
+  {
+    return rng_?buckets::used_array_size(rng_)+buckets::tail_size:0;
+  }
+
+  static bucket_array new_array(allocator_type& al_,std::size_t rng_)
+  {
+    return rng_?
+      array_allocator::allocate(al_,space_for(rng_)):
+      array_allocator::dummy();
+  }
+
+  void delete_array()noexcept
+  {
+    array_allocator::deallocate(al(),ar,space_for(rng));
+  }
+
+  void swap_all(cuckoo_filter& x)noexcept
+  {
+    using std::swap;
+    swap(al(),x.al());
+    swap(h(),x.h());
+    std::swap(rng,x.rng);
+    std::swap(size_,x.size_);
+    std::swap(ar,x.ar);
+  }
+
+  std::size_t  rng;
+  std::size_t  size_=0;
+  bucket_array ar;
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+template<
+  typename T,std::size_t FB,std::size_t BS,typename H,typename A
+>
+bool operator!=(
+  const cuckoo_filter<T,FB,BS,H,A>& x,const cuckoo_filter<T,FB,BS,H,A>& y)
+{
+  return !(x==y);
+}
+
+template<
+  typename T,std::size_t FB,std::size_t BS,typename H,typename A
+>
+void swap(cuckoo_filter<T,FB,BS,H,A>& x,cuckoo_filter<T,FB,BS,H,A>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,366 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_ARRAY_OPS_HPP
+#define BOOST_BLOOM_DETAIL_ARRAY_OPS_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/neon.hpp>
+#include <boost/bloom/detail/sse2.hpp>
+#include <boost/config.hpp>
+#include <boost/core/bit.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* Bytewise combination of filter arrays with the widest vector type
+ * available. Non-temporal (streaming) stores are used on request, which
+ * is beneficial when the destination array does not fit into the
+ * last-level cache.
+ */
+
+#if defined(BOOST_BLOOM_AVX512)
+struct array_ops_vector
+{
+  using type=__m512i;
+  static constexpr bool has_stream=true;
+
+  static type load(const unsigned char* p)
+  {
+    return _mm512_loadu_si512((const void*)p);
+  }
+
+  static void store(unsigned char* p,type x)
+  {
+    _mm512_storeu_si512((void*)p,x);
+  }
+
+  static void stream(unsigned char* p,type x) /* p aligned */
+  {
+    _mm512_stream_si512((__m512i*)p,x);
+  }
+
+  static void fence(){_mm_sfence();}
+};
+#elif defined(BOOST_BLOOM_AVX2)
+struct array_ops_vector
+{
+  using type=__m256i;
+  static constexpr bool has_stream=true;
+
+  static type load(const unsigned char* p)
+  {
+    return _mm256_loadu_si256((const __m256i*)p);
+  }
+
+  static void store(unsigned char* p,type x)
+  {
+    _mm256_storeu_si256((__m256i*)p,x);
+  }
+
+  static void stream(unsigned char* p,type x) /* p aligned */
+  {
+    _mm256_stream_si256((__m256i*)p,x);
+  }
+
+  static void fence(){_mm_sfence();}
+};
+#elif defined(BOOST_BLOOM_SSE2)
+struct array_ops_vector
+{
+  using type=__m128i;
+  static constexpr bool has_stream=true;
+
+  static type load(const unsigned char* p)
+  {
+    return _mm_loadu_si128((const __m128i*)p);
+  }
+
+  static void store(unsigned char* p,type x)
+  {
+    _mm_storeu_si128((__m128i*)p,x);
+  }
+
+  static void stream(unsigned char* p,type x) /* p aligned */
+  {
+    _mm_stream_si128((__m128i*)p,x);
+  }
+
+  static void fence(){_mm_sfence();}
+};
+#elif defined(BOOST_BLOOM_LITTLE_ENDIAN_NEON)
+struct array_ops_vector
+{
+  using type=uint8x16_t;
+  static constexpr bool has_stream=false;
+
+  static type load(const unsigned char* p){return vld1q_u8(p);}
+  static void store(unsigned char* p,type x){vst1q_u8(p,x);}
+  static void stream(unsigned char* p,type x){store(p,x);}
+  static void fence(){}
+};
+#else
+struct array_ops_vector
+{
+  using type=std::uint64_t;
+  static constexpr bool has_stream=false;
+
+  static type load(const unsigned char* p)
+  {
+    type x;
+    std::memcpy(&x,p,sizeof(x));
+    return x;
+  }
+
+  static void store(unsigned char* p,type x)
+  {
+    std::memcpy(p,&x,sizeof(x));
+  }
+
+  static void stream(unsigned char* p,type x){store(p,x);}
+  static void fence(){}
+};
+#endif
+
+struct and_op
+{
+  template<typename T>
+  static T apply(T x,T y){return (T)(x&y);}
+
+#if defined(BOOST_BLOOM_AVX512)
+  static __m512i apply(__m512i x,__m512i y){return _mm512_and_si512(x,y);}
+#elif defined(BOOST_BLOOM_AVX2)
+  static __m256i apply(__m256i x,__m256i y){return _mm256_and_si256(x,y);}
+#elif defined(BOOST_BLOOM_SSE2)
+  static __m128i apply(__m128i x,__m128i y){return _mm_and_si128(x,y);}
+#elif defined(BOOST_BLOOM_LITTLE_ENDIAN_NEON)
+  static uint8x16_t apply(uint8x16_t x,uint8x16_t y){return vandq_u8(x,y);}
+#endif
+};
+
+struct or_op
+{
+  template<typename T>
+  static T apply(T x,T y){return (T)(x|y);}
+
+#if defined(BOOST_BLOOM_AVX512)
+  static __m512i apply(__m512i x,__m512i y){return _mm512_or_si512(x,y);}
+#elif defined(BOOST_BLOOM_AVX2)
+  static __m256i apply(__m256i x,__m256i y){return _mm256_or_si256(x,y);}
+#elif defined(BOOST_BLOOM_SSE2)
+  static __m128i apply(__m128i x,__m128i y){return _mm_or_si128(x,y);}
+#elif defined(BOOST_BLOOM_LITTLE_ENDIAN_NEON)
+  static uint8x16_t apply(uint8x16_t x,uint8x16_t y){return vorrq_u8(x,y);}
+#endif
+};
+
+/* p[i]=Op::apply(p[i],q[i]) for i in [0,n). p and q may be equal, but
+ * otherwise must not overlap.
+ */
+
+template<typename Op>
+void combine_arrays(
+  unsigned char* p,const unsigned char* q,std::size_t n,bool nontemporal)
+{
+  using vector=array_ops_vector;
+  static constexpr std::size_t width=sizeof(typename vector::type);
+
+  auto last=p+n;
+  if(vector::has_stream&&nontemporal){
+    /* streaming stores require an aligned destination */
+
+    while(p!=last&&(std::uintptr_t)p%width!=0){
+      *p=Op::apply(*p,*q);
+      ++p;
+      ++q;
+    }
+    for(;std::size_t(last-p)>=width;p+=width,q+=width){
+      vector::stream(p,Op::apply(vector::load(p),vector::load(q)));
+    }
+    vector::fence();
+  }
+  else{
+    for(;std::size_t(last-p)>=width;p+=width,q+=width){
+      vector::store(p,Op::apply(vector::load(p),vector::load(q)));
+    }
+  }
+  for(;p!=last;++p,++q)*p=Op::apply(*p,*q);
+}
+
+/* count_ones(p,n) returns the number of bits set to one in [p,p+n), and
+ * count_ones(p,q,n) the numbers of bits set to one in [p,p+n), [q,q+n)
+ * and their bitwise OR, calculated in one pass. With AVX-512, VPOPCNTDQ is
+ * used if available. With AVX2, we resort to the nibble lookup technique
+ * by Mula, Kurz and Lemire (https://arxiv.org/pdf/1611.07612), with
+ * bytewise counts accumulated for up to 31 iterations before being
+ * horizontally added with _mm256_sad_epu8.
+ */
+
+struct joint_ones_count
+{
+  std::size_t x=0,y=0,x_or_y=0;
+};
+
+inline std::size_t count_ones_words(const unsigned char* p,std::size_t n)
+{
+  std::size_t res=0;
+  for(;n>=8;p+=8,n-=8){
+    std::uint64_t x;
+    std::memcpy(&x,p,sizeof(x));
+    res+=(std::size_t)boost::core::popcount(x);
+  }
+  for(;n;++p,--n)res+=(std::size_t)boost::core::popcount(*p);
+  return res;
+}
+
+inline joint_ones_count count_ones_words(
+  const unsigned char* p,const unsigned char* q,std::size_t n)
+{
+  joint_ones_count res;
+  for(;n>=8;p+=8,q+=8,n-=8){
+    std::uint64_t x,y;
+    std::memcpy(&x,p,sizeof(x));
+    std::memcpy(&y,q,sizeof(y));
+    res.x+=(std::size_t)boost::core::popcount(x);
+    res.y+=(std::size_t)boost::core::popcount(y);
+    res.x_or_y+=(std::size_t)boost::core::popcount(x|y);
+  }
+  for(;n;++p,++q,--n){
+    res.x+=(std::size_t)boost::core::popcount(*p);
+    res.y+=(std::size_t)boost::core::popcount(*q);
+    res.x_or_y+=(std::size_t)boost::core::popcount((unsigned char)(*p|*q));
+  }
+  return res;
+}
+
+#if defined(BOOST_BLOOM_AVX512)&&defined(__AVX512VPOPCNTDQ__)
+inline std::size_t reduce_add_epi64(__m512i x)
+{
+  std::uint64_t sums[8];
+  _mm512_storeu_si512((void*)sums,x);
+  return (std::size_t)(
+    sums[0]+sums[1]+sums[2]+sums[3]+sums[4]+sums[5]+sums[6]+sums[7]);
+}
+
+inline std::size_t count_ones(const unsigned char* p,std::size_t n)
+{
+  __m512i acc=_mm512_setzero_si512();
+  for(;n>=64;p+=64,n-=64){
+    acc=_mm512_add_epi64(
+      acc,_mm512_popcnt_epi64(_mm512_loadu_si512((const void*)p)));
+  }
+  return reduce_add_epi64(acc)+count_ones_words(p,n);
+}
+
+inline joint_ones_count count_ones(
+  const unsigned char* p,const unsigned char* q,std::size_t n)
+{
+  __m512i accx=_mm512_setzero_si512(),
+          accy=_mm512_setzero_si512(),
+          accxy=_mm512_setzero_si512();
+  for(;n>=64;p+=64,q+=64,n-=64){
+    __m512i x=_mm512_loadu_si512((const void*)p),
+            y=_mm512_loadu_si512((const void*)q);
+    accx=_mm512_add_epi64(accx,_mm512_popcnt_epi64(x));
+    accy=_mm512_add_epi64(accy,_mm512_popcnt_epi64(y));
+    accxy=_mm512_add_epi64(accxy,_mm512_popcnt_epi64(_mm512_or_si512(x,y)));
+  }
+  auto res=count_ones_words(p,q,n);
+  res.x+=reduce_add_epi64(accx);
+  res.y+=reduce_add_epi64(accy);
+  res.x_or_y+=reduce_add_epi64(accxy);
+  return res;
+}
+#elif defined(BOOST_BLOOM_AVX2)
+inline __m256i count_ones_epi8(__m256i x) /* bytewise */
+{
+  const __m256i lookup=_mm256_setr_epi8(
+    0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+  const __m256i low_mask=_mm256_set1_epi8(0x0f);
+  return _mm256_add_epi8(
+    _mm256_shuffle_epi8(lookup,_mm256_and_si256(x,low_mask)),
+    _mm256_shuffle_epi8(
+      lookup,_mm256_and_si256(_mm256_srli_epi16(x,4),low_mask)));
+}
+
+inline __m256i sad_epu8(__m256i x) /* horizontal sums of groups of 8 bytes */
+{
+  return _mm256_sad_epu8(x,_mm256_setzero_si256());
+}
+
+inline std::size_t reduce_add_epi64(__m256i x)
+{
+  std::uint64_t sums[4];
+  _mm256_storeu_si256((__m256i*)sums,x);
+  return (std::size_t)(sums[0]+sums[1]+sums[2]+sums[3]);
+}
+
+inline std::size_t count_ones(const unsigned char* p,std::size_t n)
+{
+  __m256i acc=_mm256_setzero_si256();
+  while(n>=32){
+    __m256i counts=_mm256_setzero_si256(); /* <=8 per byte and iteration */
+    for(int i=0;i<31&&n>=32;++i,p+=32,n-=32){
+      counts=_mm256_add_epi8(
+        counts,count_ones_epi8(_mm256_loadu_si256((const __m256i*)p)));
+    }
+    acc=_mm256_add_epi64(acc,sad_epu8(counts));
+  }
+  return reduce_add_epi64(acc)+count_ones_words(p,n);
+}
+
+inline joint_ones_count count_ones(
+  const unsigned char* p,const unsigned char* q,std::size_t n)
+{
+  __m256i accx=_mm256_setzero_si256(),
+          accy=_mm256_setzero_si256(),
+          accxy=_mm256_setzero_si256();
+  while(n>=32){
+    __m256i countsx=_mm256_setzero_si256(),
+            countsy=_mm256_setzero_si256(),
+            countsxy=_mm256_setzero_si256();
+    for(int i=0;i<31&&n>=32;++i,p+=32,q+=32,n-=32){
+      __m256i x=_mm256_loadu_si256((const __m256i*)p),
+              y=_mm256_loadu_si256((const __m256i*)q);
+      countsx=_mm256_add_epi8(countsx,count_ones_epi8(x));
+      countsy=_mm256_add_epi8(countsy,count_ones_epi8(y));
+      countsxy=_mm256_add_epi8(
+        countsxy,count_ones_epi8(_mm256_or_si256(x,y)));
+    }
+    accx=_mm256_add_epi64(accx,sad_epu8(countsx));
+    accy=_mm256_add_epi64(accy,sad_epu8(countsy));
+    accxy=_mm256_add_epi64(accxy,sad_epu8(countsxy));
+  }
+  auto res=count_ones_words(p,q,n);
+  res.x+=reduce_add_epi64(accx);
+  res.y+=reduce_add_epi64(accy);
+  res.x_or_y+=reduce_add_epi64(accxy);
+  return res;
+}
+#else
+inline std::size_t count_ones(const unsigned char* p,std::size_t n)
+{
+  return count_ones_words(p,n);
+}
+
+inline joint_ones_count count_ones(
+  const unsigned char* p,const unsigned char* q,std::size_t n)
+{
+  return count_ones_words(p,q,n);
+}
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,183 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_ATOMIC_SUBFILTER_HPP
+#define BOOST_BLOOM_DETAIL_ATOMIC_SUBFILTER_HPP
+
+#include <boost/bloom/detail/core.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if !defined(BOOST_GCC)&&!defined(BOOST_CLANG)
+#include <atomic>
+#endif
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Relaxed atomic operations on plain memory locations. In the absence of
+ * GCC-style __atomic builtins, we resort to reinterpreting the location as
+ * a std::atomic object, which is layout-compatible with the underlying
+ * integral type on all relevant platforms.
+ */
+
+template<typename Word>
+BOOST_FORCEINLINE Word atomic_fetch_or_relaxed(Word* p,Word x)
+{
+#if defined(BOOST_GCC)||defined(BOOST_CLANG)
+  return __atomic_fetch_or(p,x,__ATOMIC_RELAXED);
+#else
+  static_assert(
+    sizeof(std::atomic<Word>)==sizeof(Word),
+    "std::atomic<Word> must be layout-compatible with Word");
+  return reinterpret_cast<std::atomic<Word>*>(p)->
+    fetch_or(x,std::memory_order_relaxed);
+#endif
+}
+
+template<typename Word>
+BOOST_FORCEINLINE Word atomic_load_relaxed(const Word* p)
+{
+#if defined(BOOST_GCC)||defined(BOOST_CLANG)
+  return __atomic_load_n(p,__ATOMIC_RELAXED);
+#else
+  return reinterpret_cast<const std::atomic<Word>*>(p)->
+    load(std::memory_order_relaxed);
+#endif
+}
+
+/* Largest unsigned integral type, no wider than std::size_t, whose size
+ * divides both the stride and the used value size of Subfilter: blocks
+ * are then accessed as arrays of properly aligned words, so that they can
+ * be atomically updated regardless of the subfilter's value_type.
+ */
+
+template<std::size_t N>
+struct unsigned_integral_of_size;
+
+template<>
+struct unsigned_integral_of_size<1>{using type=std::uint8_t;};
+template<>
+struct unsigned_integral_of_size<2>{using type=std::uint16_t;};
+template<>
+struct unsigned_integral_of_size<4>{using type=std::uint32_t;};
+template<>
+struct unsigned_integral_of_size<8>{using type=std::uint64_t;};
+
+template<typename Subfilter,std::size_t Stride>
+struct atomic_subfilter_word
+{
+  static constexpr std::size_t used_value_size=
+    detail::used_value_size<Subfilter>::value;
+  static constexpr std::size_t stride=Stride?Stride:used_value_size;
+  static constexpr std::size_t max_size=
+    sizeof(std::size_t)<8?sizeof(std::size_t):8;
+  static constexpr std::size_t size=
+    gcd_pow2(stride,max_size)<gcd_pow2(used_value_size,max_size)?
+    gcd_pow2(stride,max_size):gcd_pow2(used_value_size,max_size);
+
+  using type=typename unsigned_integral_of_size<size>::type;
+};
+
+/* Adaptor turning Subfilter into a subfilter safe for concurrent marking
+ * and checking. Marking computes the subfilter's fingerprint on a local
+ * block and ORs its non-zero words into the filter array with atomic
+ * fetch_or, whereas checking takes a snapshot of the block with atomic
+ * loads and then delegates to Subfilter::check. SIMD subfilters thus keep
+ * their vectorized fingerprint calculation and testing, with atomic
+ * operations confined to the word-by-word transfer to and from memory.
+ */
+
+template<typename Subfilter,std::size_t Stride>
+struct atomic_subfilter:Subfilter
+{
+private:
+  using word_type=typename atomic_subfilter_word<Subfilter,Stride>::type;
+  using subfilter_value_type=typename Subfilter::value_type;
+  static constexpr std::size_t subfilter_used_value_size=
+    detail::used_value_size<Subfilter>::value;
+  static constexpr std::size_t num_words=
+    subfilter_used_value_size/sizeof(word_type);
+
+public:
+  using value_type=word_type[num_words];
+  static constexpr std::size_t used_value_size=sizeof(value_type);
+
+  static BOOST_FORCEINLINE void mark(value_type& x,std::uint64_t hash)
+  {
+    subfilter_value_type fp;
+    fingerprint(fp,hash);
+    for(std::size_t i=0;i<num_words;++i){
+      auto w=word_at(fp,i);
+      if(w)atomic_fetch_or_relaxed(&x[i],w);
+    }
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,std::uint64_t hash)
+  {
+    subfilter_value_type y;
+    for(std::size_t i=0;i<num_words;++i){
+      auto w=atomic_load_relaxed(&x[i]);
+      std::memcpy(
+        reinterpret_cast<unsigned char*>(&y)+i*sizeof(word_type),
+        &w,sizeof(word_type));
+    }
+    std::memset(
+      reinterpret_cast<unsigned char*>(&y)+subfilter_used_value_size,0,
+      sizeof(subfilter_value_type)-subfilter_used_value_size);
+    return Subfilter::check(y,hash);
+  }
+
+  static BOOST_FORCEINLINE bool try_mark(value_type& x,std::uint64_t hash)
+  {
+    subfilter_value_type fp;
+    fingerprint(fp,hash);
+    bool res=false;
+    for(std::size_t i=0;i<num_words;++i){
+      auto w=word_at(fp,i);
+      if(w)res|=(atomic_fetch_or_relaxed(&x[i],w)&w)!=w;
+    }
+    return res;
+  }
+
+private:
+  static BOOST_FORCEINLINE void fingerprint(
+    subfilter_value_type& fp,std::uint64_t hash)
+  {
+    std::memset(&fp,0,sizeof(fp));
+    Subfilter::mark(fp,hash);
+  }
+
+  static BOOST_FORCEINLINE word_type word_at(
+    const subfilter_value_type& x,std::size_t i)
+  {
+    word_type w;
+    std::memcpy(
+      &w,reinterpret_cast<const unsigned char*>(&x)+i*sizeof(word_type),
+      sizeof(word_type));
+    return w;
+  }
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -53,6 +53,11 @@ struct block_ops
   {
     return (x&y)==y;
   }
+
+  static BOOST_FORCEINLINE void set_mask(value_type& x,const value_type& y)
+  {
+    x|=y;
+  }
 };
 
 template<typename Block,std::size_t N>
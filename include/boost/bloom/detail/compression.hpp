@@ -0,0 +1,605 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_COMPRESSION_HPP
+#define BOOST_BLOOM_DETAIL_COMPRESSION_HPP
+
+#include <algorithm>
+#include <boost/bloom/detail/crc32c.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/throw_exception.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* Compressed encodings of a filter array for serialization. Bit i of the
+ * array is bit i%8 of byte i/8, and the array is described by the gaps
+ * g_j=pos_j-pos_{j-1}-1 between the positions of consecutive set bits
+ * (pos_{-1}=-1). Gaps are either
+ *   - sparse_encoding: stored as LEB128 varints, fast to decode and suited
+ *     to very sparse arrays, or
+ *   - rice_encoding: Golomb-Rice coded with parameter r, i.e. g>>r in unary
+ *     (as zeros followed by a one) plus the low r bits of g, with bits
+ *     packed LSB first. For uniformly random bits, which is what filter
+ *     arrays look like, gaps are geometrically distributed and the
+ *     resulting size is within a few percent of the entropy of the array.
+ * choose_encoding measures the exact size of each encoding in a pass over
+ * the array and selects the smallest, or raw_encoding (the array itself)
+ * if no encoding saves at least 1/8 of the array size. Both encoder and decoder work in fixed-size chunks so that no
+ * buffer proportional to the array size is ever allocated, and decoding
+ * sets bits directly on the destination array, which must be zeroed
+ * beforehand.
+ */
+
+static constexpr std::uint32_t raw_encoding=0;
+static constexpr std::uint32_t sparse_encoding=1;
+static constexpr std::uint32_t rice_encoding=2;
+static constexpr std::size_t   compression_chunk_size=64*1024;
+static constexpr unsigned      max_rice_parameter=56;
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::uint64_t load_little_endian_uint64(const unsigned char* p)
+{
+  std::uint64_t x;
+  if(boost::core::endian::native==boost::core::endian::little){
+    std::memcpy(&x,p,sizeof(x));
+  }
+  else{
+    x=0;
+    for(int i=7;i>=0;--i)x=(x<<8)|p[i];
+  }
+  return x;
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline void store_little_endian_uint64(unsigned char* p,std::uint64_t x)
+{
+  if(boost::core::endian::native==boost::core::endian::little){
+    std::memcpy(p,&x,sizeof(x));
+  }
+  else{
+    for(int i=0;i<8;++i,x>>=8)p[i]=(unsigned char)x;
+  }
+}
+
+/* invokes f(pos) for each set bit of the array in increasing order */
+
+template<typename F>
+void for_each_set_bit(const unsigned char* p,std::size_t n,F f)
+{
+  std::size_t i=0;
+  for(;i+8<=n;i+=8){
+    auto w=load_little_endian_uint64(p+i);
+    while(w){
+      f((std::uint64_t)i*8+(unsigned)boost::core::countr_zero(w));
+      w&=w-1;
+    }
+  }
+  for(;i<n;++i){
+    unsigned w=p[i];
+    while(w){
+      f((std::uint64_t)i*8+(unsigned)boost::core::countr_zero(w));
+      w&=w-1;
+    }
+  }
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::uint64_t count_set_bits(const unsigned char* p,std::size_t n)
+{
+  std::uint64_t res=0;
+  std::size_t   i=0;
+  for(;i+8<=n;i+=8){
+    res+=(unsigned)boost::core::popcount(load_little_endian_uint64(p+i));
+  }
+  for(;i<n;++i)res+=(unsigned)boost::core::popcount((unsigned)p[i]);
+  return res;
+}
+
+struct encoding_choice
+{
+  std::uint32_t encoding;
+  std::uint32_t parameter;    /* r for rice_encoding */
+  std::uint64_t num_ones;
+  std::uint64_t payload_size; /* in bytes */
+};
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline encoding_choice choose_encoding(
+  const unsigned char* p,std::size_t n,std::size_t overhead)
+{
+  encoding_choice res={raw_encoding,0,0,n};
+  std::uint64_t   num_ones=count_set_bits(p,n);
+
+  /* Near optimal Rice parameter for a geometric distribution of mean mu
+   * is log2(mu*ln2); neighboring values are measured too.
+   */
+
+  static constexpr int num_params=3;
+  unsigned             r[num_params];
+  double               mu=num_ones?(double)(n*8-num_ones)/num_ones:0.0;
+  int                  r0=mu*0.6931471805599453>1.0?
+                          (int)std::log2(mu*0.6931471805599453):0;
+  for(int i=0;i<num_params;++i){
+    r[i]=(unsigned)(std::min)(
+      (std::max)(r0+i-1,0),(int)max_rice_parameter);
+  }
+
+  std::uint64_t sparse_size=0,
+                rice_bits[num_params]={0,0,0},
+                prev=0; /* pos_{j-1}+1 */
+  for_each_set_bit(p,n,[&](std::uint64_t pos){
+    std::uint64_t g=pos-prev;
+    prev=pos+1;
+    std::uint64_t len=1;
+    for(std::uint64_t x=g;x>=128;x>>=7)++len;
+    sparse_size+=len;
+    for(int i=0;i<num_params;++i)rice_bits[i]+=(g>>r[i])+1+r[i];
+  });
+
+  /* Decoding is slower than reading the raw array, so encodings must
+   * save at least 1/min_gain_divisor of its size to be chosen.
+   */
+
+  static constexpr std::uint64_t min_gain_divisor=8;
+
+  std::uint64_t limit=n-n/min_gain_divisor; /* size+overhead must be less */
+  if(sparse_size+overhead<limit){
+    res={sparse_encoding,0,num_ones,sparse_size};
+    limit=sparse_size+overhead;
+  }
+  for(int i=0;i<num_params;++i){
+    auto rice_size=(rice_bits[i]+7)/8;
+    if(rice_size+overhead<limit){
+      res={rice_encoding,r[i],num_ones,rice_size};
+      limit=rice_size+overhead;
+    }
+  }
+  return res;
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+BOOST_NORETURN inline void throw_corrupted_data()
+{
+  BOOST_THROW_EXCEPTION(std::runtime_error("corrupted array"));
+}
+
+class chunked_output
+{
+public:
+  explicit chunked_output(std::ostream& os_):
+    os(os_),buf(compression_chunk_size){}
+
+  void put(unsigned char c)
+  {
+    if(pos==buf.size())flush();
+    buf[pos++]=c;
+  }
+
+  void write(const unsigned char* p,std::size_t n)
+  {
+    while(n){
+      if(pos==buf.size())flush();
+      auto m=(std::min)(n,buf.size()-pos);
+      std::memcpy(buf.data()+pos,p,m);
+      pos+=m;
+      p+=m;
+      n-=m;
+    }
+  }
+
+  void flush()
+  {
+    crc=crc32c(crc,buf.data(),pos);
+    os.write(reinterpret_cast<const char*>(buf.data()),(std::streamsize)pos);
+    pos=0;
+  }
+
+  std::uint32_t checksum()const{return crc;}
+
+private:
+  std::ostream&              os;
+  std::vector<unsigned char> buf;
+  std::size_t                pos=0;
+  std::uint32_t              crc=0;
+};
+
+class chunked_input
+{
+public:
+  /* crc_ is the checksum of the data preceding the input */
+
+  chunked_input(std::istream& is_,std::uint64_t size,std::uint32_t crc_=0):
+    is(is_),remaining(size),
+    buf((std::size_t)(std::min)(
+      (std::uint64_t)compression_chunk_size,size)),
+    crc(crc_){}
+
+  bool get(unsigned char& c)
+  {
+    if(pos==end&&!fill())return false;
+    c=buf[pos++];
+    return true;
+  }
+
+  void read(unsigned char* p,std::size_t n)
+  {
+    while(n){
+      if(pos==end&&!fill())throw_corrupted_data();
+      auto m=(std::min)(n,end-pos);
+      std::memcpy(p,buf.data()+pos,m);
+      pos+=m;
+      p+=m;
+      n-=m;
+    }
+  }
+
+  /* Points p to the unread bytes in the buffer and returns their number,
+   * which is at least min_size (<=compression_chunk_size) unless the
+   * input is about to end.
+   */
+
+  std::size_t peek(const unsigned char*& p,std::size_t min_size)
+  {
+    if(end-pos<min_size)fill();
+    p=buf.data()+pos;
+    return end-pos;
+  }
+
+  void skip(std::size_t n){pos+=n;}
+
+  bool exhausted()const{return pos==end&&remaining==0;}
+  std::uint32_t checksum()const{return crc;}
+
+private:
+  /* moves unread bytes to the front of the buffer and fills the rest */
+
+  bool fill()
+  {
+    if(remaining==0)return false;
+    if(pos!=0){
+      std::memmove(buf.data(),buf.data()+pos,end-pos);
+      end-=pos;
+      pos=0;
+    }
+    auto n=(std::size_t)(std::min)(
+      (std::uint64_t)(buf.size()-end),remaining);
+    if(!is.read(reinterpret_cast<char*>(buf.data()+end),(std::streamsize)n)){
+      BOOST_THROW_EXCEPTION(std::runtime_error("read error"));
+    }
+    crc=crc32c(crc,buf.data()+end,n);
+    remaining-=n;
+    end+=n;
+    return true;
+  }
+
+  std::istream&              is;
+  std::uint64_t              remaining;
+  std::vector<unsigned char> buf;
+  std::size_t                pos=0,end=0;
+  std::uint32_t              crc;
+};
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline void encode_sparse(
+  const unsigned char* p,std::size_t n,chunked_output& out)
+{
+  std::uint64_t prev=0;
+  for_each_set_bit(p,n,[&](std::uint64_t pos){
+    std::uint64_t g=pos-prev;
+    prev=pos+1;
+    for(;g>=128;g>>=7)out.put((unsigned char)(g|128));
+    out.put((unsigned char)g);
+  });
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline void encode_rice(
+  const unsigned char* p,std::size_t n,unsigned r,chunked_output& out)
+{
+  std::uint64_t acc=0, /* nacc<32 pending bits */
+                prev=0;
+  unsigned      nacc=0;
+
+  /* len<=32 */
+  auto put_bits=[&](std::uint64_t x,unsigned len){
+    acc|=x<<nacc;
+    nacc+=len;
+    if(nacc>=32){
+      unsigned char b[4]={
+        (unsigned char)acc,(unsigned char)(acc>>8),
+        (unsigned char)(acc>>16),(unsigned char)(acc>>24)};
+      out.write(b,4);
+      acc>>=32;
+      nacc-=32;
+    }
+  };
+
+  for_each_set_bit(p,n,[&](std::uint64_t pos){
+    std::uint64_t g=pos-prev;
+    prev=pos+1;
+    std::uint64_t q=g>>r;
+    for(;q>=32;q-=32)put_bits(0,32);
+    put_bits((std::uint64_t)1<<q,(unsigned)q+1);
+    if(r>32){
+      put_bits(g&0xFFFFFFFFu,32);
+      put_bits((g>>32)&(((std::uint64_t)1<<(r-32))-1),r-32);
+    }
+    else if(r)put_bits(g&(((std::uint64_t)1<<r)-1),r);
+  });
+  for(;nacc>0;nacc-=(std::min)(nacc,8u),acc>>=8){
+    out.put((unsigned char)acc);
+  }
+}
+
+/* Sets bits at increasing positions given by the gaps between them.
+ * Bits are accumulated in the 64-bit word of the array containing the
+ * last position set, and the whole word is stored after each update:
+ * setting bits with byte-wise read-modify-write operations would make
+ * nearby positions wait on one another through memory. Words are only
+ * ever stored with all their bits, so the array must be zeroed
+ * beforehand.
+ */
+
+class position_setter
+{
+public:
+  position_setter(unsigned char* p_,std::size_t n_):
+    p{p_},n{n_},num_bits{(std::uint64_t)n_*8}{}
+
+  void set_next(std::uint64_t g)
+  {
+    if(g>=num_bits-next)throw_corrupted_data();
+    next+=g;
+    move_to_next();
+    acc|=(std::uint64_t)1<<(next&63);
+    if(n-word*8>=8)store_little_endian_uint64(p+word*8,acc);
+    else store_tail(word,acc);
+    ++next;
+  }
+
+  /* Sets the bits of mask at offsets from the next position and advances
+   * len positions, where the highest bit of mask is len-1 and len<64.
+   */
+
+  void set_next_bits(std::uint64_t mask,unsigned len)
+  {
+    if(len>num_bits-next)throw_corrupted_data();
+    move_to_next();
+    auto shift=(unsigned)(next&63);
+    auto lo=acc|(mask<<shift),
+         hi=(mask>>1)>>(63-shift); /* bits spilling over to word+1 */
+    if(n-word*8>=16){
+      store_little_endian_uint64(p+word*8,lo);
+      store_little_endian_uint64(p+word*8+8,hi);
+    }
+    else{
+      store_tail(word,lo);
+      store_tail(word+1,hi);
+    }
+    next+=len;
+    acc=(next>>6)!=word?hi:lo;
+    word=next>>6;
+  }
+
+private:
+  void move_to_next()
+  {
+    auto w=next>>6;
+    acc=w==word?acc:0;
+    word=w;
+  }
+
+  void store_tail(std::uint64_t w,std::uint64_t x)
+  {
+    for(auto i=w*8;i<n&&i<w*8+8;++i,x>>=8)p[i]=(unsigned char)x;
+  }
+
+  unsigned char* p;
+  std::size_t    n;
+  std::uint64_t  num_bits;
+  std::uint64_t  next=0,
+                 word=0, /* word of the last position set */
+                 acc=0;  /* contents of word */
+};
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline void decode_sparse(
+  unsigned char* p,std::size_t n,std::uint64_t num_ones,chunked_input& in)
+{
+  static constexpr std::size_t max_varint_size=10;
+
+  position_setter ps{p,n};
+  for(;num_ones--;){
+    std::uint64_t        g=0;
+    const unsigned char* q;
+    if(in.peek(q,max_varint_size)>=max_varint_size){ /* fast path */
+      for(std::size_t i=0;;++i){
+        g|=(std::uint64_t)(q[i]&127)<<(7*i);
+        if(!(q[i]&128)){
+          in.skip(i+1);
+          break;
+        }
+        if(i==max_varint_size-1)throw_corrupted_data();
+      }
+    }
+    else{
+      unsigned char c;
+      for(unsigned shift=0;;shift+=7){
+        if(shift>=64||!in.get(c))throw_corrupted_data();
+        g|=(std::uint64_t)(c&127)<<shift;
+        if(!(c&128))break;
+      }
+    }
+    ps.set_next(g);
+  }
+  if(!in.exhausted())throw_corrupted_data();
+}
+
+/* Multi-symbol Rice decoding: entry i of the table for parameter r
+ * describes the complete symbols at the start of the rice_table_bits-bit
+ * sequence i (read LSB first) whose positions lie within 48 bits of the
+ * current one. Bits 0-47 of the entry hold the mask of these positions,
+ * bits 48-51 the number of input bits consumed, bits 52-55 the number of
+ * symbols and bits 56-61 the position advance. Entries with no symbols are
+ * zero, and their sequences are decoded one symbol at a time. The table
+ * only pays off when symbols are short enough that each lookup decodes
+ * several of them, that is, for small r (dense arrays).
+ */
+
+static constexpr unsigned      rice_table_bits=12;
+static constexpr std::size_t   rice_table_size=std::size_t(1)<<rice_table_bits;
+static constexpr unsigned      max_rice_table_parameter=4;
+static constexpr std::uint64_t rice_table_mask=
+  ((std::uint64_t)1<<48)-1;
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline void make_rice_table(unsigned r,std::uint64_t* table)
+{
+  for(unsigned i=0;i<rice_table_size;++i){
+    unsigned      bit=0,advance=0,num_symbols=0;
+    std::uint64_t mask=0;
+    for(;;){
+      unsigned q=0;
+      while(bit+q<rice_table_bits&&!((i>>(bit+q))&1))++q;
+      if(bit+q+1+r>rice_table_bits)break;
+      unsigned g=(q<<r)|((i>>(bit+q+1))&((1u<<r)-1));
+      if(advance+g>=48)break;
+      mask|=(std::uint64_t)1<<(advance+g);
+      advance+=g+1;
+      bit+=q+1+r;
+      ++num_symbols;
+    }
+    table[i]=num_symbols?
+      mask|((std::uint64_t)bit<<48)|((std::uint64_t)num_symbols<<52)|
+      ((std::uint64_t)advance<<56):
+      0;
+  }
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline void decode_rice(
+  unsigned char* p,std::size_t n,std::uint64_t num_ones,unsigned r,
+  chunked_input& in)
+{
+  /* Symbols are read with unaligned 64-bit loads at arbitrary bit offsets,
+   * each providing at least 57 valid bits, which is usually enough for the
+   * unary part and the remainder altogether, or for several table lookups.
+   * Decoding stops margin bytes short of the end of the input buffer so
+   * that loads never go past it; the last bytes of the input are copied to
+   * a zero-padded array and decoded there, with overruns detected
+   * afterwards.
+   */
+
+  static constexpr std::size_t margin=16,
+                               min_window=4*margin;
+
+  if(r>max_rice_parameter)throw_corrupted_data();
+
+  std::vector<std::uint64_t> table;
+  if(r<=max_rice_table_parameter&&num_ones>=rice_table_size){
+    table.resize(rice_table_size);
+    make_rice_table(r,table.data());
+  }
+
+  position_setter     ps{p,n};
+  const std::uint64_t mask=((std::uint64_t)1<<r)-1,
+                      max_q=((std::uint64_t)n*8)>>r;
+  std::uint64_t       q=0,  /* unary part decoded so far */
+                      bit=0;
+
+  auto decode=[&](const unsigned char* data,std::uint64_t num_bits){
+    /* Local copies of the state, as stores to the array could otherwise
+     * alias it and force reloads on every symbol.
+     */
+
+    auto           ps_=ps;
+    auto           q_=q,bit_=bit,num_ones_=num_ones;
+    const auto*    table_=table.empty()?nullptr:table.data();
+    while(num_ones_&&bit_<num_bits){
+      auto shift=(unsigned)(bit_&7),
+           avail=64-shift;
+      auto w=load_little_endian_uint64(data+(bit_>>3))>>shift;
+      if(table_&&!q_){
+        auto avail0=avail;
+        while(avail>=rice_table_bits&&num_ones_>=rice_table_bits){
+          auto e=table_[w&(rice_table_size-1)];
+          if(!e)break;
+          auto consumed=(unsigned)(e>>48)&15;
+          ps_.set_next_bits(e&rice_table_mask,(unsigned)(e>>56));
+          w>>=consumed;
+          avail-=consumed;
+          bit_+=consumed;
+          num_ones_-=(e>>52)&15;
+        }
+        if(avail!=avail0)continue;
+      }
+      if(!w){
+        q_+=avail;
+        bit_+=avail;
+        if(q_>max_q)throw_corrupted_data();
+        continue;
+      }
+      auto tz=(unsigned)boost::core::countr_zero(w);
+      q_+=tz;
+      bit_+=tz+1;
+      if(q_>max_q)throw_corrupted_data();
+      std::uint64_t g=q_<<r;
+      if(r){
+        if(tz+1+r<=avail)g|=(w>>(tz+1))&mask;
+        else{
+          g|=(load_little_endian_uint64(data+(bit_>>3))>>(bit_&7))&mask;
+        }
+        bit_+=r;
+      }
+      ps_.set_next(g);
+      q_=0;
+      --num_ones_;
+    }
+    ps=ps_;
+    q=q_;
+    bit=bit_;
+    num_ones=num_ones_;
+  };
+
+  const unsigned char* data;
+  while(num_ones){
+    auto m=in.peek(data,min_window);
+    if(m>=min_window)decode(data,(m-margin)*8);
+    else{ /* end of input */
+      unsigned char tail[min_window+margin]={};
+      if(m)std::memcpy(tail,data,m);
+      decode(tail,m*8);
+      if(num_ones||bit>m*8)throw_corrupted_data();
+    }
+    in.skip((std::size_t)(bit>>3));
+    bit&=7;
+  }
+
+  /* padding bits of the last byte must be zero */
+
+  if(bit){
+    if(!in.peek(data,1)||(data[0]>>bit))throw_corrupted_data();
+    in.skip(1);
+  }
+  if(!in.exhausted())throw_corrupted_data();
+}
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -13,8 +13,11 @@
 
 #include <algorithm>
 #include <boost/assert.hpp>
+#include <boost/bloom/detail/array_ops.hpp>
 #include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/parallel.hpp>
 #include <boost/bloom/detail/sse2.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
 #include <boost/config.hpp>
 #include <boost/core/allocator_traits.hpp>
 #include <boost/core/empty_value.hpp>
@@ -30,6 +33,7 @@
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 /* We use BOOST_BLOOM_PREFETCH[_WRITE] macros rather than proper
  * functions because of https://gcc.gnu.org/bugzilla/show_bug.cgi?id=109985
@@ -52,6 +56,23 @@ _mm_prefetch((const char*)(p),_MM_HINT_T0)
 #define BOOST_BLOOM_PREFETCH_WRITE(p) ((void)(p))
 #endif
 
+/* Bulk operations pipeline their work so that a number of cachelines are
+ * being prefetched at the same time. The default value is a good fit for
+ * modern CPUs, but it can be tuned by the user if necessary.
+ */
+
+#if !defined(BOOST_BLOOM_BULK_PREFETCHED_CACHELINES)
+#define BOOST_BLOOM_BULK_PREFETCHED_CACHELINES 16
+#endif
+
+/* If BOOST_BLOOM_NONTEMPORAL_COMBINE_THRESHOLD is defined, combination of
+ * filters (operator&=, operator|=) uses non-temporal stores for arrays at
+ * least this size (in bytes), which should then be set to the size of the
+ * last-level cache of the target architecture. This is not enabled by
+ * default as the destination array is read before being written to, and
+ * gains are highly platform dependent.
+ */
+
 namespace boost{
 namespace bloom{
 namespace detail{
@@ -92,13 +113,15 @@ struct fastrange_and_mcg
     boost::uint64_t hi;
     umul128(hash,rng,hi);
 
+    hash*=multiplier;
+    return (std::size_t)hi;
+  }
+
 #if ((((SIZE_MAX>>16)>>16)>>16)>>15)!=0 /* 64-bit mode (or higher) */
-    hash*=0xf1357aea2e62a9c5ull;
+  static constexpr std::uint64_t multiplier=0xf1357aea2e62a9c5ull;
 #else /* 32-bit mode */
-    hash*=0xe817fb2d;
+  static constexpr std::uint64_t multiplier=0xe817fb2d;
 #endif
-    return (std::size_t)hi;
-  }
 
   std::uint64_t rng;
 };
@@ -124,6 +147,40 @@ struct used_value_size<
   static constexpr std::size_t value=Subfilter::used_value_size;
 };
 
+/* bulk_kernels<Subfilter>::get() returns the kernels with which the
+ * pipelined bulk operations of filter_core process each window of blocks.
+ * By default these are no_bulk_kernels, and blocks are marked and checked
+ * one by one with Subfilter::mark and Subfilter::check. Subfilters can
+ * instead provide a static member function bulk_kernels() returning an
+ * object bk with
+ *   - bk.mark_blocks(ps,hashes,n): marks block ps[i] for hashes[i],
+ *   - bk.check_blocks(ps,hashes,n,res): res[i]&=check of ps[i] for
+ *     hashes[i],
+ * for i<n and ps[i] not necessarily aligned. This is obtained once per bulk
+ * operation, which allows run-time dispatched subfilters to select their
+ * implementation once per operation rather than once per element.
+ */
+
+struct no_bulk_kernels{};
+
+template<typename Subfilter,typename=void>
+struct bulk_kernels
+{
+  static no_bulk_kernels get(){return {};}
+};
+
+template<typename Subfilter>
+struct bulk_kernels<
+  Subfilter,
+  boost::void_t<decltype(Subfilter::bulk_kernels())>
+>
+{
+  static auto get()->decltype(Subfilter::bulk_kernels())
+  {
+    return Subfilter::bulk_kernels();
+  }
+};
+
 /* GCD with x,p > 1, p a power of two */
 
 constexpr std::size_t gcd_pow2(std::size_t x,std::size_t p)
@@ -139,12 +196,144 @@ constexpr double constexpr_ldexp_1_positive(int exp)
   return exp==0?1.0:2.0*constexpr_ldexp_1_positive(exp-1);
 }
 
+/* Number of subfilter operations k per element: a compile-time constant for
+ * K>0, and a run-time value held by the K==0 specialization otherwise.
+ */
+
+template<std::size_t K>
+struct k_storage
+{
+  k_storage()=default;
+  explicit k_storage(std::size_t k_)noexcept
+  {
+    BOOST_ASSERT(k_==K);
+    (void)k_;
+  }
+
+  static constexpr std::size_t get_k()noexcept{return K;}
+};
+
+template<>
+struct k_storage<0>
+{
+  k_storage()=default;
+  explicit k_storage(std::size_t k_):kv{k_}
+  {
+    if(k_==0){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("k must be >= 1"));
+    }
+  }
+
+  std::size_t get_k()const noexcept{return kv;}
+
+  std::size_t kv=1;
+};
+
+/* Layout of the array of filter_core (and of the counters of
+ * counting_filter): rng overlapping blocks of Subfilter::value_type, each
+ * starting stride bytes after the previous one, so that the array spans
+ * (rng-1)*stride+used_value_size bytes. The array is allocated with
+ * tail_size extra bytes so that the last block can be accessed in full.
+ */
+
+template<typename Subfilter,std::size_t Stride>
+struct block_layout
+{
+  using block_type=typename Subfilter::value_type;
+  static constexpr std::size_t block_size=sizeof(block_type);
+  static constexpr std::size_t used_value_size=
+    detail::used_value_size<Subfilter>::value;
+  static constexpr std::size_t stride=Stride?Stride:used_value_size;
+  static_assert(
+    stride<=used_value_size,"Stride can't exceed the block size");
+
+  static constexpr std::size_t tail_size=block_size-stride;
+  static constexpr bool are_blocks_aligned=
+    (stride%alignof(block_type)==0);
+  static constexpr std::size_t cacheline=64; /* unknown at compile time */
+  static constexpr std::size_t initial_alignment=
+    are_blocks_aligned?
+      alignof(block_type)>cacheline?alignof(block_type):cacheline:
+      1;
+  static constexpr std::size_t prefetched_cachelines=
+    1+(block_size+cacheline-1-gcd_pow2(stride,cacheline))/cacheline;
+
+  /* range for a requested capacity of m bits */
+
+  static std::size_t requested_range(std::size_t m)
+  {
+    if(m>(used_value_size-stride)*CHAR_BIT){
+      /* ensures filter_core{f.capacity()}.capacity()==f.capacity() */
+      m-=(used_value_size-stride)*CHAR_BIT;
+    }
+    return
+      (std::numeric_limits<std::size_t>::max)()-m>=stride*CHAR_BIT-1?
+      (m+stride*CHAR_BIT-1)/(stride*CHAR_BIT):
+      m/(stride*CHAR_BIT);
+  }
+
+  static std::size_t used_array_size(std::size_t rng)noexcept
+  {
+    return rng?rng*stride+(used_value_size-stride):0;
+  }
+};
+
 struct filter_array
 {
   unsigned char* data;
   unsigned char* array; /* adjusted from data for proper alignment */
 };
 
+/* Allocation of arrays of n>0 bytes aligned to Alignment. To avoid dynamic
+ * allocation for zero capacity or moved-from filters, dummy() returns
+ * a filter_array with null data pointing to a statically allocated array
+ * of DummySize bytes with value DummyValue. This is good for read
+ * operations but not so for write operations, where users need to resort
+ * to a null check on filter_array::data. The dummy array is shared by all
+ * filters with the same template arguments and must never be written to.
+ */
+
+template<
+  std::size_t Alignment,std::size_t DummySize,unsigned char DummyValue
+>
+struct aligned_array
+{
+  template<typename Allocator>
+  static filter_array allocate(Allocator& al,std::size_t n)
+  {
+    BOOST_ASSERT(n!=0);
+    auto p=allocator_allocate(al,space_for(n));
+    return {p,align(p)};
+  }
+
+  static filter_array dummy()noexcept
+  {
+    static struct {unsigned char x=DummyValue;}
+    dummy_[space_for(DummySize)];
+
+    return {nullptr,align(reinterpret_cast<unsigned char*>(&dummy_))};
+  }
+
+  template<typename Allocator>
+  static void deallocate(
+    Allocator& al,const filter_array& ar,std::size_t n)noexcept
+  {
+    if(ar.data)allocator_deallocate(al,ar.data,space_for(n));
+  }
+
+private:
+  static constexpr std::size_t space_for(std::size_t n)noexcept
+  {
+    return (Alignment-1)+n;
+  }
+
+  static unsigned char* align(unsigned char* p)noexcept
+  {
+    return p+
+      (std::uintptr_t(Alignment)-std::uintptr_t(p))%Alignment;
+  }
+};
+
 struct if_constexpr_void_else{void operator()()const{}};
 
 template<bool B,typename F,typename G=if_constexpr_void_else>
@@ -174,9 +363,15 @@ void swap_if(T&,T&){}
 template<
   std::size_t K,typename Subfilter,std::size_t Stride,typename Allocator
 >
-class filter_core:empty_value<Allocator,0>
+class
+
+#if defined(_MSC_VER)&&_MSC_FULL_VER>=190023918
+__declspec(empty_bases) /* activate EBO with multiple inheritance */
+#endif
+
+filter_core:empty_value<Allocator,0>,k_storage<K>
 {
-  static_assert(K>0,"K must be >= 1");
+  /* K==0 stands for k specified at run time */
   static_assert(
     std::is_same<allocator_value_type_t<Allocator>,unsigned char>::value,
     "Allocator value_type must be unsigned char");
@@ -187,49 +382,82 @@ public:
 
 private:
   static constexpr std::size_t kp=subfilter::k;
-  static constexpr std::size_t k_total=k*kp;
-  using block_type=typename subfilter::value_type;
-  static constexpr std::size_t block_size=sizeof(block_type);
-  static constexpr std::size_t used_value_size=
-    detail::used_value_size<subfilter>::value;
+  using layout=block_layout<Subfilter,Stride>;
+  using block_type=typename layout::block_type;
+  static constexpr std::size_t block_size=layout::block_size;
+  static constexpr std::size_t used_value_size=layout::used_value_size;
 
 public:
-  static constexpr std::size_t stride=Stride?Stride:used_value_size;
-  static_assert(
-    stride<=used_value_size,"Stride can't exceed the block size");
+  static constexpr std::size_t stride=layout::stride;
 
 private:
-  static constexpr std::size_t tail_size=sizeof(block_type)-stride;
-  static constexpr bool are_blocks_aligned=
-    (stride%alignof(block_type)==0);
-  static constexpr std::size_t cacheline=64; /* unknown at compile time */
-  static constexpr std::size_t initial_alignment=
-    are_blocks_aligned?
-      alignof(block_type)>cacheline?alignof(block_type):cacheline:
-      1;
+  static constexpr std::size_t tail_size=layout::tail_size;
+  static constexpr bool are_blocks_aligned=layout::are_blocks_aligned;
+  static constexpr std::size_t cacheline=layout::cacheline;
+  static constexpr std::size_t initial_alignment=layout::initial_alignment;
   static constexpr std::size_t prefetched_cachelines=
-    1+(block_size+cacheline-1-gcd_pow2(stride,cacheline))/cacheline;
+    layout::prefetched_cachelines;
+
+  /* A zero range always yields position 0, so the dummy array must
+   * accommodate one full block, as well as the cachelines prefetched by
+   * next_element. All bits are set to one so that lookups succeed.
+   */
+
+  using array_allocator=aligned_array<
+    initial_alignment,
+    (stride+tail_size>prefetched_cachelines*cacheline?
+     stride+tail_size:prefetched_cachelines*cacheline),
+    (unsigned char)-1>;
   using hash_strategy=detail::fastrange_and_mcg;
 
 public:
+  static constexpr std::size_t bulk_insert_size=
+    (BOOST_BLOOM_BULK_PREFETCHED_CACHELINES+prefetched_cachelines-1)/
+    prefetched_cachelines;
+  static constexpr std::size_t bulk_may_contain_size=bulk_insert_size;
   using allocator_type=Allocator;
   using size_type=std::size_t;
   using difference_type=std::ptrdiff_t;
   using pointer=unsigned char*;
   using const_pointer=const unsigned char*;
+  using k_base=k_storage<K>;
 
   explicit filter_core(std::size_t m=0):filter_core{m,allocator_type{}}{}
 
   filter_core(std::size_t m,const allocator_type& al_):
+    filter_core{k_base{},m,al_}{}
+
+  filter_core(std::size_t n,double fpr,const allocator_type& al_):
+    filter_core{k_base{},n,fpr,al_}{}
+
+  filter_core(const k_base& kb_,std::size_t m,const allocator_type& al_):
     allocator_base{empty_init,al_},
+    k_base{kb_},
     hs{requested_range(m)},
     ar(new_array(al(),m?hs.range():0))
   {
     clear_bytes();
   }
 
-  filter_core(std::size_t n,double fpr,const allocator_type& al_):
-    filter_core(unadjusted_capacity_for(n,fpr),al_){}
+  filter_core(
+    const k_base& kb_,std::size_t n,double fpr,const allocator_type& al_):
+    filter_core{kb_,unadjusted_capacity_for(kb_.get_k(),n,fpr),al_}{}
+
+  /* Non-owning core over an externally provided array with the layout
+   * returned by array() (used by filter_view). ar.data is null, so the
+   * array is never deallocated; the core must not be written to.
+   */
+
+  filter_core(
+    const k_base& kb_,boost::span<const unsigned char> x,
+    const allocator_type& al_):
+    allocator_base{empty_init,al_},
+    k_base{kb_},
+    hs{range_for_array(x)},
+    ar(hs.range()?
+      filter_array{nullptr,const_cast<unsigned char*>(x.data())}:
+      new_array(al(),0))
+  {}
 
   filter_core(const filter_core& x):
     filter_core{x,allocator_select_on_container_copy_construction(x.al())}{}
@@ -239,6 +467,7 @@ public:
 
   filter_core(const filter_core& x,const allocator_type& al_):
     allocator_base{empty_init,al_},
+    k_base{x.kb()},
     hs{x.hs},
     ar(new_array(al(),x.range()))
   {
@@ -247,6 +476,7 @@ public:
 
   filter_core(filter_core&& x,const allocator_type& al_):
     allocator_base{empty_init,al_},
+    k_base{x.kb()},
     hs{x.hs}
   {
     auto empty_ar=new_array(x.al(),0); /* we're relying on this not throwing */
@@ -293,6 +523,7 @@ public:
         }
       });
       copy_bytes(x);
+      kb()=x.kb();
     }
     return *this;
   }
@@ -328,6 +559,7 @@ public:
         copy_bytes(x);
         x.delete_array();
       }
+      kb()=x.kb();
       x.hs=hash_strategy{0};
       x.ar=empty_ar;
     }
@@ -348,9 +580,17 @@ public:
     return used_array_size()*CHAR_BIT;
   }
 
+  using k_base::get_k;
+
   static std::size_t capacity_for(std::size_t n,double fpr)
   {
-    auto m=unadjusted_capacity_for(n,fpr);
+    return capacity_for(k_base{},n,fpr);
+  }
+
+  static std::size_t capacity_for(
+    const k_base& kb_,std::size_t n,double fpr)
+  {
+    auto m=unadjusted_capacity_for(kb_.get_k(),n,fpr);
     if(m==0)return 0;
     auto rng=hash_strategy{requested_range(m)}.range();
     return used_array_size(rng)*CHAR_BIT;
@@ -358,31 +598,138 @@ public:
 
   static double fpr_for(std::size_t n,std::size_t m)
   {
-    return m==0?1.0:n==0?0.0:fpr_for_c((double)m/n);
+    return fpr_for(k_base{},n,m);
+  }
+
+  static double fpr_for(const k_base& kb_,std::size_t n,std::size_t m)
+  {
+    return m==0?1.0:n==0?0.0:fpr_for_c(kb_.get_k(),(double)m/n);
+  }
+
+  std::size_t estimated_size()const noexcept
+  {
+    return estimated_size_for(count_ones());
+  }
+
+  double estimated_fpr()const noexcept
+  {
+    return fpr_for(kb(),estimated_size(),capacity());
+  }
+
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  std::size_t parallel_estimated_size(std::size_t num_threads)const
+  {
+    return estimated_size_for(parallel_count_ones(num_threads));
+  }
+
+  double parallel_estimated_fpr(std::size_t num_threads)const
+  {
+    return fpr_for(kb(),parallel_estimated_size(num_threads),capacity());
+  }
+#endif
+
+  /* Set cardinalities of the elements inserted into *this and x, as
+   * estimated from the bits set in their arrays and in their union (the
+   * array of *this|x) without materializing the latter.
+   * |A&B| = |A|+|B|-|A|B| (Swamidass and Baldi 2007,
+   * https://doi.org/10.1021/ci600358f).
+   */
+
+  std::size_t estimated_union_size(const filter_core& x)const
+  {
+    check_combinable(x);
+    return estimated_size_for(count_ones(x).x_or_y);
+  }
+
+  std::size_t estimated_intersection_size(const filter_core& x)const
+  {
+    check_combinable(x);
+    return estimated_intersection_size(count_ones(x));
+  }
+
+  double estimated_jaccard_similarity(const filter_core& x)const
+  {
+    check_combinable(x);
+    auto c=count_ones(x);
+    auto n=estimated_size_for(c.x_or_y);
+    return n==0?0.0:(double)estimated_intersection_size(c)/n;
   }
 
   boost::span<unsigned char> array()noexcept
   {
-    return {ar.data?ar.array:nullptr,capacity()/CHAR_BIT};
+    return {range()?ar.array:nullptr,capacity()/CHAR_BIT};
   }
 
   boost::span<const unsigned char> array()const noexcept
   {
-    return {ar.data?ar.array:nullptr,capacity()/CHAR_BIT};
+    return {range()?ar.array:nullptr,capacity()/CHAR_BIT};
   }
 
   BOOST_FORCEINLINE void insert(std::uint64_t hash)
   {
-    hs.prepare_hash(hash);
-    for(auto n=k;n--;){
-      auto p=next_element(hash); /* modifies h */
-      /* We do the unhappy-path null check here rather than at the beginning
-       * of the function because prefetch completion wait gives us free CPU
-       * cycles to spare.
-       */
-      if(BOOST_UNLIKELY(n==k-1&&ar.data==nullptr))return;
+    dispatch_k(insert_op{this,hash});
+  }
 
-      set(p,hash);
+  /* Marks the bits for hash as insert does, visiting each block only
+   * once, and returns true iff at least one bit was not previously set.
+   */
+
+  BOOST_FORCEINLINE bool try_insert(std::uint64_t hash)
+  {
+    return dispatch_k(try_insert_op{this,hash});
+  }
+
+  /* Hashes for the next bulk_insert_size elements are obtained from the
+   * stream h, and their first positions prefetched before proceeding with
+   * the actual bit setting, so that cache misses are overlapped. For k>1,
+   * the same is done for each subsequent round of positions. In the steady
+   * state, the last round for a window is interleaved with the first round
+   * for the next one.
+   */
+
+  template<typename HashStream>
+  void bulk_insert(HashStream h,std::size_t n)
+  {
+    if(BOOST_UNLIKELY(ar.data==nullptr))return;
+
+    const std::size_t k_=get_k();
+    const auto        bk=detail::bulk_kernels<subfilter>::get();
+    std::uint64_t     hashes[bulk_insert_size];
+    unsigned char*    positions[bulk_insert_size];
+
+    if(n>=bulk_insert_size){
+      for(std::size_t i=0;i<bulk_insert_size;++i){
+        hashes[i]=h();
+        hs.prepare_hash(hashes[i]);
+        positions[i]=next_element(hashes[i]);
+      }
+      n-=bulk_insert_size;
+      for(;;){
+        for(std::size_t j=k_-1;j--;){
+          set_blocks(bk,positions,hashes,bulk_insert_size,[&](std::size_t i){
+            positions[i]=next_element(hashes[i]);
+          });
+        }
+        if(n<bulk_insert_size)break;
+        set_blocks(bk,positions,hashes,bulk_insert_size,[&](std::size_t i){
+          hashes[i]=h();
+          hs.prepare_hash(hashes[i]);
+          positions[i]=next_element(hashes[i]);
+        });
+        n-=bulk_insert_size;
+      }
+      set_blocks(bk,positions,hashes,bulk_insert_size,[](std::size_t){});
+    }
+
+    for(std::size_t i=0;i<n;++i){
+      hashes[i]=h();
+      hs.prepare_hash(hashes[i]);
+      positions[i]=next_element(hashes[i]);
+    }
+    for(std::size_t j=k_;j--;){
+      set_blocks(bk,positions,hashes,n,[&](std::size_t i){
+        if(j)positions[i]=next_element(hashes[i]);
+      });
     }
   }
 
@@ -400,6 +747,7 @@ public:
       BOOST_ASSERT(al()==x.al());
       (void)this; /* makes sure captured this is used */
     });
+    std::swap(kb(),x.kb());
     std::swap(hs,x.hs);
     std::swap(ar,x.ar);
   }
@@ -424,27 +772,388 @@ public:
 
   void reset(std::size_t n,double fpr)
   {
-    reset(capacity_for(n,fpr));
+    reset(capacity_for(kb(),n,fpr));
   }
 
   filter_core& operator&=(const filter_core& x)
   {
-    combine(x,[](unsigned char& a,unsigned char b){a&=b;});
+    combine<and_op>(x);
     return *this;
   }
 
   filter_core& operator|=(const filter_core& x)
   {
-    combine(x,[](unsigned char& a,unsigned char b){a|=b;});
+    combine<or_op>(x);
     return *this;
   }
 
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  void parallel_and(const filter_core& x,std::size_t num_threads)
+  {
+    parallel_combine<and_op>(x,num_threads);
+  }
+
+  void parallel_or(const filter_core& x,std::size_t num_threads)
+  {
+    parallel_combine<or_op>(x,num_threads);
+  }
+#endif
+
   BOOST_FORCEINLINE bool may_contain(std::uint64_t hash)const
+  {
+    return dispatch_k(may_contain_op{this,hash});
+  }
+
+  /* Same pipelining scheme as bulk_insert. Lookup results are reported
+   * in order through f. Rounds for k>1 don't short-circuit on negative
+   * partial results, as that would stall the pipeline.
+   */
+
+  template<typename HashStream,typename F>
+  void bulk_may_contain(HashStream h,std::size_t n,F f)const
+  {
+    std::uint64_t        hashes[bulk_may_contain_size];
+    const unsigned char* positions[bulk_may_contain_size];
+    bool                 results[bulk_may_contain_size];
+    const std::size_t    k_=get_k();
+    const auto           bk=detail::bulk_kernels<subfilter>::get();
+
+    if(n>=bulk_may_contain_size){
+      for(std::size_t i=0;i<bulk_may_contain_size;++i){
+        hashes[i]=h();
+        hs.prepare_hash(hashes[i]);
+        positions[i]=next_element(hashes[i]);
+        results[i]=true;
+      }
+      n-=bulk_may_contain_size;
+      for(;;){
+        for(std::size_t j=k_-1;j--;){
+          get_blocks(
+            bk,positions,hashes,bulk_may_contain_size,results,
+            [&](std::size_t i){positions[i]=next_element(hashes[i]);});
+        }
+        if(n<bulk_may_contain_size)break;
+        get_blocks(
+          bk,positions,hashes,bulk_may_contain_size,results,
+          [&](std::size_t i){
+            f(results[i]);
+            hashes[i]=h();
+            hs.prepare_hash(hashes[i]);
+            positions[i]=next_element(hashes[i]);
+            results[i]=true;
+          });
+        n-=bulk_may_contain_size;
+      }
+      get_blocks(
+        bk,positions,hashes,bulk_may_contain_size,results,
+        [&](std::size_t i){f(results[i]);});
+    }
+
+    for(std::size_t i=0;i<n;++i){
+      hashes[i]=h();
+      hs.prepare_hash(hashes[i]);
+      positions[i]=next_element(hashes[i]);
+      results[i]=true;
+    }
+    for(std::size_t j=k_;j--;){
+      get_blocks(bk,positions,hashes,n,results,[&](std::size_t i){
+        if(j)positions[i]=next_element(hashes[i]);
+      });
+    }
+    for(std::size_t i=0;i<n;++i)f(results[i]);
+  }
+
+  /* Bulk lookup with results written to a bitmap of (n+63)/64 words (bit
+   * i%64 of word i/64 for the i-th element, unused bits of the last word
+   * set to zero) or to a selection vector with the indices of the positive
+   * elements. Accumulation is branchless except for the per-word store.
+   * Both return the number of positive elements.
+   */
+
+  template<typename HashStream>
+  std::size_t bulk_may_contain_bitmap(
+    HashStream h,std::size_t n,std::uint64_t* bitmap)const
+  {
+    std::size_t   res=0,i=0;
+    std::uint64_t word=0;
+    bulk_may_contain(h,n,[&](bool b){
+      word|=std::uint64_t(b)<<i;
+      res+=b;
+      if(++i==64){
+        *bitmap++=word;
+        word=0;
+        i=0;
+      }
+    });
+    if(i)*bitmap=word;
+    return res;
+  }
+
+  template<typename HashStream,typename Index>
+  std::size_t bulk_may_contain_selection(
+    HashStream h,std::size_t n,Index* selection)const
+  {
+    std::size_t res=0,i=0;
+    bulk_may_contain(h,n,[&](bool b){
+      selection[res]=static_cast<Index>(i++);
+      res+=b;
+    });
+    return res;
+  }
+
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  /* Partitioned parallel insertion of the n hashes given by hash_at(i).
+   * The array is divided into num_threads slices of contiguous positions,
+   * each owned by a thread. Hashes are processed in chunks, each chunk
+   * comprising two phases separated by barriers:
+   *
+   *   - Routing: each thread takes its share of the chunk, calculates the k
+   *     (position,hash) pairs for each hash value and sorts them by owner
+   *     slice into a private buffer.
+   *   - Marking: each thread marks the pairs routed to its slice by all
+   *     threads using plain (non-atomic) memory accesses.
+   *
+   * Pairs whose block extends beyond the end of its slice (this can only
+   * happen at slice boundaries) are deferred and marked by thread #0 during
+   * the routing phase of the next chunk, when no other thread is writing to
+   * the array. Routing buffers are double-buffered for this purpose.
+   */
+
+  template<typename HashAt>
+  void parallel_insert(HashAt hash_at,std::size_t n,std::size_t num_threads)
+  {
+    if(ar.data==nullptr||n==0)return;
+    if(num_threads>range())num_threads=range();
+    if(num_threads<=1||n<=parallel_insert_chunk_size){
+      std::size_t i=0;
+      bulk_insert([&]{return hash_at(i++);},n);
+      return;
+    }
+
+    using entry_allocator_type=
+      allocator_rebind_t<allocator_type,parallel_insert_entry>;
+    using size_allocator_type=allocator_rebind_t<allocator_type,std::size_t>;
+
+    const std::size_t nt=num_threads,
+                      slice_size=(range()+nt-1)/nt,
+                      k_=get_k(),
+                      max_entries=parallel_insert_chunk_size*k_,
+                      num_buckets=nt+1, /* last bucket for deferred pairs */
+                      num_chunks=
+                        (n+nt*parallel_insert_chunk_size-1)/
+                        (nt*parallel_insert_chunk_size);
+
+    /* All buffers are allocated upfront so that workers don't throw. */
+
+    std::vector<parallel_insert_entry,entry_allocator_type>
+      scratch(nt*max_entries,entry_allocator_type(al())),
+      routed(2*nt*max_entries,entry_allocator_type(al()));
+    std::vector<std::size_t,size_allocator_type>
+      offsets(2*nt*(num_buckets+1),size_allocator_type(al())),
+      cursors(nt*num_buckets,size_allocator_type(al()));
+    detail::exception_holder eh;
+
+    auto bucket_of=[&](std::size_t pos){
+      std::size_t s=pos/slice_size;
+      if(s<nt-1&&pos*stride+block_size>(s+1)*slice_size*stride)return nt;
+      else return s;
+    };
+    auto routed_entries=[&](std::size_t buf,std::size_t t){
+      return routed.data()+(buf*nt+t)*max_entries;
+    };
+    auto routed_offsets=[&](std::size_t buf,std::size_t t){
+      return offsets.data()+(buf*nt+t)*(num_buckets+1);
+    };
+    auto mark_routed=[&](std::size_t buf,std::size_t bucket){
+      for(std::size_t t=0;t<nt;++t){
+        auto e=routed_entries(buf,t);
+        auto off=routed_offsets(buf,t);
+        mark_entries(e+off[bucket],e+off[bucket+1]);
+      }
+    };
+
+    detail::run_parallel(nt,[&](std::size_t t,detail::barrier& bar){
+      for(std::size_t c=0;c<num_chunks;++c){
+        std::size_t buf=c%2;
+        if(t==0&&c>0)mark_routed(buf^1,nt); /* deferred pairs */
+
+        /* routing */
+
+        std::size_t first=(c*nt+t)*parallel_insert_chunk_size,
+                    last=first+parallel_insert_chunk_size;
+        if(first>n)first=n;
+        if(last>n)last=n;
+
+        auto scr=scratch.data()+t*max_entries;
+        auto e=routed_entries(buf,t);
+        auto off=routed_offsets(buf,t);
+        auto cur=cursors.data()+t*num_buckets;
+        std::size_t ne=0;
+        for(std::size_t b=0;b<=num_buckets;++b)off[b]=0;
+        BOOST_TRY{
+          for(std::size_t i=first;i<last;++i){
+            std::uint64_t hash=hash_at(i);
+            hs.prepare_hash(hash);
+            for(std::size_t j=0;j<k_;++j){
+              auto pos=hs.next_position(hash);
+              scr[ne++]={pos,hash};
+              ++off[bucket_of(pos)+1];
+            }
+          }
+        }
+        BOOST_CATCH(...){
+          eh.capture();
+          ne=0;
+          for(std::size_t b=0;b<=num_buckets;++b)off[b]=0;
+        }
+        BOOST_CATCH_END
+        for(std::size_t b=0;b<num_buckets;++b){
+          off[b+1]+=off[b];
+          cur[b]=off[b];
+        }
+        for(std::size_t i=0;i<ne;++i){
+          e[cur[bucket_of(scr[i].pos)]++]=scr[i];
+        }
+
+        if(!bar.arrive_and_wait()||eh.captured())return;
+
+        /* marking */
+
+        mark_routed(buf,t);
+
+        if(!bar.arrive_and_wait())return;
+      }
+      if(t==0)mark_routed((num_chunks-1)%2,nt);
+    });
+    eh.rethrow_if_captured();
+  }
+#endif
+
+  friend bool operator==(const filter_core& x,const filter_core& y)
+  {
+    if(x.range()!=y.range()||x.get_k()!=y.get_k())return false;
+    else if(!x.range())return true;
+    else return std::memcmp(x.ar.array,y.ar.array,x.used_array_size())==0;
+  }
+
+private:
+  using allocator_base=empty_value<Allocator,0>;
+
+  const Allocator& al()const{return allocator_base::get();}
+  Allocator& al(){return allocator_base::get();}
+  const k_base& kb()const{return *this;}
+  k_base& kb(){return *this;}
+
+  /* Per-element operations are written against a number of rounds KC
+   * which, for a compile-time K, is std::integral_constant<std::size_t,K>.
+   * For a run-time k, the most common values are dispatched to equivalent
+   * compile-time constants so that the inner loops get fully unrolled as
+   * in the static case, and the rest are handled with a plain std::size_t.
+   */
+
+  template<std::size_t N>
+  using k_constant=std::integral_constant<std::size_t,N>;
+
+  template<typename Op>
+  BOOST_FORCEINLINE auto dispatch_k(Op op)const->decltype(op(std::size_t{}))
+  {
+    return dispatch_k(op,std::integral_constant<bool,(K>0)>{});
+  }
+
+  template<typename Op>
+  BOOST_FORCEINLINE auto dispatch_k(Op op,std::true_type /* static k */)const
+    ->decltype(op(std::size_t{}))
+  {
+    return op(k_constant<K>{});
+  }
+
+  template<typename Op>
+  auto dispatch_k(Op op,std::false_type /* dynamic k */)const
+    ->decltype(op(std::size_t{}))
+  {
+    switch(get_k()){
+      case 1:  return op(k_constant<1>{});
+      case 2:  return op(k_constant<2>{});
+      case 3:  return op(k_constant<3>{});
+      case 4:  return op(k_constant<4>{});
+      case 5:  return op(k_constant<5>{});
+      case 6:  return op(k_constant<6>{});
+      case 7:  return op(k_constant<7>{});
+      case 8:  return op(k_constant<8>{});
+      default: return op(get_k());
+    }
+  }
+
+  struct insert_op
+  {
+    template<typename KC>
+    BOOST_FORCEINLINE void operator()(KC k_)const{p->insert(hash,k_);}
+
+    filter_core*  p;
+    std::uint64_t hash;
+  };
+
+  struct try_insert_op
+  {
+    template<typename KC>
+    BOOST_FORCEINLINE bool operator()(KC k_)const
+    {
+      return p->try_insert(hash,k_);
+    }
+
+    filter_core*  p;
+    std::uint64_t hash;
+  };
+
+  struct may_contain_op
+  {
+    template<typename KC>
+    BOOST_FORCEINLINE bool operator()(KC k_)const
+    {
+      return p->may_contain(hash,k_);
+    }
+
+    const filter_core* p;
+    std::uint64_t      hash;
+  };
+
+  template<typename KC>
+  BOOST_FORCEINLINE void insert(std::uint64_t hash,KC k_)
+  {
+    hs.prepare_hash(hash);
+    for(std::size_t n=k_;n--;){
+      auto p=next_element(hash); /* modifies h */
+      /* We do the unhappy-path null check here rather than at the beginning
+       * of the function because prefetch completion wait gives us free CPU
+       * cycles to spare.
+       */
+      if(BOOST_UNLIKELY(n==k_-1&&ar.data==nullptr))return;
+
+      set(p,hash);
+    }
+  }
+
+  template<typename KC>
+  BOOST_FORCEINLINE bool try_insert(std::uint64_t hash,KC k_)
+  {
+    hs.prepare_hash(hash);
+    bool res=false;
+    for(std::size_t n=k_;n--;){
+      auto p=next_element(hash); /* modifies h */
+      if(BOOST_UNLIKELY(n==k_-1&&ar.data==nullptr))return false;
+
+      res|=try_set(p,hash);
+    }
+    return res;
+  }
+
+  template<typename KC>
+  BOOST_FORCEINLINE bool may_contain(std::uint64_t hash,KC k_)const
   {
     hs.prepare_hash(hash);
 #if 1
     auto p0=next_element(hash);
-    for(std::size_t n=k-1;n--;){
+    for(std::size_t n=k_-1;n--;){
       auto p=p0;
       auto hash0=hash;
       p0=next_element(hash);
@@ -453,7 +1162,7 @@ public:
     if(!get(p0,hash))return false;
     return true;
 #else
-    for(auto n=k;n--;){
+    for(std::size_t n=k_;n--;){
       auto p=next_element(hash); /* modifies hash */
       if(!get(p,hash))return false;
     }
@@ -461,55 +1170,35 @@ public:
 #endif
   }
 
-  friend bool operator==(const filter_core& x,const filter_core& y)
+  static std::size_t requested_range(std::size_t m)
   {
-    if(x.range()!=y.range())return false;
-    else if(!x.ar.data)return true;
-    else return std::memcmp(x.ar.array,y.ar.array,x.used_array_size())==0;
+    return layout::requested_range(m);
   }
 
-private:
-  using allocator_base=empty_value<Allocator,0>;
-
-  const Allocator& al()const{return allocator_base::get();}
-  Allocator& al(){return allocator_base::get();}
-
-  static std::size_t requested_range(std::size_t m)
+  static std::size_t range_for_array(boost::span<const unsigned char> x)
   {
-    if(m>(used_value_size-stride)*CHAR_BIT){
-      /* ensures filter_core{f.capacity()}.capacity()==f.capacity() */
-      m-=(used_value_size-stride)*CHAR_BIT;
+    if(x.size()==0)return 0;
+    if(x.size()<used_value_size||
+       (x.size()-(used_value_size-stride))%stride!=0){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("invalid array size"));
     }
-    return
-      (std::numeric_limits<std::size_t>::max)()-m>=stride*CHAR_BIT-1?
-      (m+stride*CHAR_BIT-1)/(stride*CHAR_BIT):
-      m/(stride*CHAR_BIT);
+    if(are_blocks_aligned&&
+       std::uintptr_t(x.data())%alignof(block_type)!=0){
+      BOOST_THROW_EXCEPTION(std::invalid_argument("misaligned array"));
+    }
+    return (x.size()-(used_value_size-stride))/stride;
   }
 
   static filter_array new_array(allocator_type& al,std::size_t rng)
   {
-    if(rng){
-      auto p=allocator_allocate(al,space_for(rng));
-      return {p,array_for(p)};
-    }
-    else{
-      /* To avoid dynamic allocation for zero capacity or moved-from filters,
-       * we point array to a statically allocated dummy array with all bits
-       * set to one. This is good for read operations but not so for write
-       * operations, where we need to resort to a null check on
-       * filter_array::data.
-       */
-
-      static struct {unsigned char x=-1;}
-      dummy[space_for(hash_strategy{0}.range())];
-
-      return {nullptr,array_for(reinterpret_cast<unsigned char*>(&dummy))};
-    }
+    return rng?
+      array_allocator::allocate(al,space_for(rng)):
+      array_allocator::dummy();
   }
 
   void delete_array()noexcept
   {
-    if(ar.data)allocator_deallocate(al(),ar.data,space_for(range()));
+    array_allocator::deallocate(al(),ar,space_for(range()));
   }
 
   void clear_bytes()noexcept
@@ -525,19 +1214,12 @@ private:
 
   std::size_t range()const noexcept
   {
-    return ar.data?hs.range():0;
+    return hs.range();
   }
 
   static constexpr std::size_t space_for(std::size_t rng)noexcept
   {
-    return (initial_alignment-1)+rng*stride+tail_size;
-  }
-
-  static unsigned char* array_for(unsigned char* p)noexcept
-  {
-    return p+
-      (std::uintptr_t(initial_alignment)-
-       std::uintptr_t(p))%initial_alignment;
+    return rng*stride+tail_size;
   }
 
   std::size_t used_array_size()const noexcept
@@ -547,10 +1229,11 @@ private:
 
   static std::size_t used_array_size(std::size_t rng)noexcept
   {
-    return rng?rng*stride+(used_value_size-stride):0;
+    return layout::used_array_size(rng);
   }
 
-  static std::size_t unadjusted_capacity_for(std::size_t n,double fpr)
+  static std::size_t unadjusted_capacity_for(
+    std::size_t k_,std::size_t n,double fpr)
   {
     using size_t_limits=std::numeric_limits<std::size_t>;
     using double_limits=std::numeric_limits<double>;
@@ -573,7 +1256,8 @@ private:
      * c = k / -log(1 - fpr^(1/k)).
      */
     
-    double d=1.0-std::pow(fpr,1.0/k_total);
+    const std::size_t k_total=k_*kp;
+    double            d=1.0-std::pow(fpr,1.0/k_total);
     if(std::fpclassify(d)==FP_ZERO)return 0; /* fpr ~ 1 */
     double l=std::log(d);
     if(std::fpclassify(l)==FP_ZERO)return (std::size_t)(c_max*n); /* fpr ~ 0 */
@@ -582,36 +1266,81 @@ private:
     /* bracket target fpr between c0 and c1 */
 
     double c1=c0;
-    if(fpr_for_c(c1)>fpr){ /* expected case */
+    if(fpr_for_c(k_,c1)>fpr){ /* expected case */
       do{
         double cn=c1*1.5;
         if(cn>c_max)return (std::size_t)(c_max*n);
         c0=c1;
         c1=cn;
-      }while(fpr_for_c(c1)>fpr);
+      }while(fpr_for_c(k_,c1)>fpr);
     }
     else{ /* c0 shouldn't overshoot ever, just in case */
       do{
         double cn=c0/1.5;
         c1=c0;
         c0=cn;
-      }while(fpr_for_c(c0)<fpr);
+      }while(fpr_for_c(k_,c0)<fpr);
     }
 
     /* bisect */
 
     double cm;
     while((cm=c0+(c1-c0)/2)>c0 && cm<c1 && c1-c0>=eps){
-      if(fpr_for_c(cm)>fpr)c0=cm;
+      if(fpr_for_c(k_,cm)>fpr)c0=cm;
       else                 c1=cm;
     }
     return (std::size_t)(cm*n);
   }
 
-  static double fpr_for_c(double c)
+  std::size_t count_ones()const noexcept
+  {
+    return detail::count_ones(ar.array,used_array_size());
+  }
+
+  detail::joint_ones_count count_ones(const filter_core& x)const noexcept
+  {
+    return detail::count_ones(ar.array,x.ar.array,used_array_size());
+  }
+
+  std::size_t estimated_intersection_size(
+    const detail::joint_ones_count& c)const noexcept
+  {
+    auto nx=estimated_size_for(c.x),
+         ny=estimated_size_for(c.y),
+         nxy=estimated_size_for(c.x_or_y);
+    auto res=(double)nx+(double)ny-(double)nxy;
+    if(res<=0.0)return 0;
+    return (std::min)((std::size_t)res,(std::min)(nx,ny));
+  }
+
+  /* Estimated number of elements whose insertion results in the given
+   * number of bits set to one. Following the model of fpr_for_c, a
+   * subfilter operation sets any given bit of its block (of w bits) with
+   * probability fpr(1,w)^(1/kp), and hence sets d=w*fpr(1,w)^(1/kp) bits on
+   * average (d=kp for multiblock, slightly less for block due to
+   * collisions). Assuming bits set are evenly spread across the m bits of
+   * the array, the expected fraction of ones after inserting n elements is
+   * 1-(1-d/m)^(k*n), which we invert.
+   */
+
+  std::size_t estimated_size_for(std::size_t ones)const noexcept
+  {
+    const std::size_t m=capacity();
+    if(ones==0||m==0)return 0;
+    if(ones>=m)return (std::numeric_limits<std::size_t>::max)();
+
+    constexpr std::size_t w=used_value_size*CHAR_BIT;
+    const double          d=w*std::pow(subfilter::fpr(1,w),1.0/kp);
+    const double          n=
+      std::log1p(-(double)ones/m)/(get_k()*std::log1p(-d/m));
+    return (std::size_t)(n+0.5);
+  }
+
+  static double fpr_for_c(std::size_t k_,double c)
   {
     constexpr std::size_t w=(2*used_value_size-stride)*CHAR_BIT;
-    const double          lambda=w*k/c;
+    const std::size_t     k_total=k_*kp;
+    const double          lambda=w*k_/c;
     const double          loglambda=std::log(lambda);
     double                res=0.0;
     double                deltap=0.0;
@@ -636,7 +1365,7 @@ private:
      */
 
     return (std::max)(
-      std::pow((double)res,(double)k),
+      std::pow((double)res,(double)k_),
       std::pow(1.0-std::exp(-(double)k_total/c),(double)k_total));
   }
 
@@ -683,6 +1412,101 @@ private:
     std::memcpy(p,&x,block_size);
   }
 
+  /* Marks (checks) a window of blocks with the bulk kernels bk, then
+   * invokes f(i) for each block. Without bulk kernels, f(i) is invoked
+   * right after processing block i, as the pipeline did originally.
+   */
+
+  template<typename F>
+  BOOST_FORCEINLINE void set_blocks(
+    detail::no_bulk_kernels,unsigned char* const* ps,
+    const std::uint64_t* hashes,std::size_t n,F f)
+  {
+    for(std::size_t i=0;i<n;++i){
+      set(ps[i],hashes[i]);
+      f(i);
+    }
+  }
+
+  template<typename BulkKernels,typename F>
+  BOOST_FORCEINLINE void set_blocks(
+    const BulkKernels& bk,unsigned char* const* ps,
+    const std::uint64_t* hashes,std::size_t n,F f)
+  {
+    bk.mark_blocks(ps,hashes,n);
+    for(std::size_t i=0;i<n;++i)f(i);
+  }
+
+  template<typename F>
+  BOOST_FORCEINLINE void get_blocks(
+    detail::no_bulk_kernels,const unsigned char* const* ps,
+    const std::uint64_t* hashes,std::size_t n,bool* res,F f)const
+  {
+    for(std::size_t i=0;i<n;++i){
+      res[i]&=get(ps[i],hashes[i]);
+      f(i);
+    }
+  }
+
+  template<typename BulkKernels,typename F>
+  BOOST_FORCEINLINE void get_blocks(
+    const BulkKernels& bk,const unsigned char* const* ps,
+    const std::uint64_t* hashes,std::size_t n,bool* res,F f)const
+  {
+    bk.check_blocks(ps,hashes,n,res);
+    for(std::size_t i=0;i<n;++i)f(i);
+  }
+
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  static constexpr std::size_t parallel_insert_chunk_size=8192;
+
+  struct parallel_insert_entry
+  {
+    std::size_t   pos;
+    std::uint64_t hash;
+  };
+
+  void mark_entries(
+    const parallel_insert_entry* first,const parallel_insert_entry* last)
+  {
+    /* prefetch distance is the same as in bulk_insert */
+    static constexpr std::size_t lookahead=bulk_insert_size;
+
+    for(auto it=first;it!=last;++it){
+      if(std::size_t(last-it)>lookahead){
+        auto p=ar.array+it[lookahead].pos*stride;
+        for(std::size_t i=0;i<prefetched_cachelines;++i){
+          BOOST_BLOOM_PREFETCH_WRITE((unsigned char*)p+i*cacheline);
+        }
+      }
+      set(ar.array+it->pos*stride,it->hash);
+    }
+  }
+#endif
+
+  BOOST_FORCEINLINE bool try_set(unsigned char* p,std::uint64_t hash)
+  {
+    return try_set(p,hash,std::integral_constant<bool,are_blocks_aligned>{});
+  }
+
+  BOOST_FORCEINLINE bool try_set(
+    unsigned char* p,std::uint64_t hash,
+    std::true_type /* blocks aligned */)
+  {
+    return subfilter::try_mark(*reinterpret_cast<block_type*>(p),hash);
+  }
+
+  BOOST_FORCEINLINE bool try_set(
+    unsigned char* p,std::uint64_t hash,
+    std::false_type /* blocks not aligned */)
+  {
+    block_type x;
+    std::memcpy(&x,p,block_size);
+    bool res=subfilter::try_mark(x,hash);
+    std::memcpy(p,&x,block_size);
+    return res;
+  }
+
   BOOST_FORCEINLINE 
   unsigned char* next_element(std::uint64_t& h)noexcept
   {
@@ -703,18 +1527,76 @@ private:
     return p;
   }
 
-  template<typename F>
-  void combine(const filter_core& x,F f)
+  void check_combinable(const filter_core& x)const
   {
-    if(range()!=x.range()){
+    if(range()!=x.range()||get_k()!=x.get_k()){
       BOOST_THROW_EXCEPTION(std::invalid_argument("incompatible filters"));
     }
-    auto first0=ar.array,
-         last0=first0+used_array_size(),
-         first1=x.ar.array;
-    while(first0!=last0)f(*first0++,*first1++);
   }
 
+  static bool use_nontemporal_combine(std::size_t n)
+  {
+#if defined(BOOST_BLOOM_NONTEMPORAL_COMBINE_THRESHOLD)
+    return n>=(std::size_t)(BOOST_BLOOM_NONTEMPORAL_COMBINE_THRESHOLD);
+#else
+    (void)n;
+    return false;
+#endif
+  }
+
+  template<typename Op>
+  void combine(const filter_core& x)
+  {
+    check_combinable(x);
+    auto n=used_array_size();
+    combine_arrays<Op>(ar.array,x.ar.array,n,use_nontemporal_combine(n));
+  }
+
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  static constexpr std::size_t parallel_combine_min_size=1024*1024;
+
+  template<typename Op>
+  void parallel_combine(const filter_core& x,std::size_t num_threads)
+  {
+    check_combinable(x);
+    auto n=used_array_size();
+    if(num_threads<=1||n<2*parallel_combine_min_size){
+      combine_arrays<Op>(ar.array,x.ar.array,n,use_nontemporal_combine(n));
+      return;
+    }
+
+    /* slices are made cacheline-aligned relative to the array start */
+
+    auto nontemporal=use_nontemporal_combine(n);
+    auto nt=(std::min)(num_threads,n/parallel_combine_min_size);
+    auto slice_size=((n+nt-1)/nt+cacheline-1)/cacheline*cacheline;
+    detail::run_parallel(nt,[&](std::size_t t,detail::barrier&){
+      auto first=(std::min)(t*slice_size,n),
+           last=(std::min)(first+slice_size,n);
+      combine_arrays<Op>(
+        ar.array+first,x.ar.array+first,last-first,nontemporal);
+    });
+  }
+
+  std::size_t parallel_count_ones(std::size_t num_threads)const
+  {
+    auto n=used_array_size();
+    if(num_threads<=1||n<2*parallel_combine_min_size)return count_ones();
+
+    auto nt=(std::min)(num_threads,n/parallel_combine_min_size);
+    auto slice_size=((n+nt-1)/nt+cacheline-1)/cacheline*cacheline;
+    std::vector<std::size_t> counts(nt);
+    detail::run_parallel(nt,[&](std::size_t t,detail::barrier&){
+      auto first=(std::min)(t*slice_size,n),
+           last=(std::min)(first+slice_size,n);
+      counts[t]=detail::count_ones(ar.array+first,last-first);
+    });
+    std::size_t res=0;
+    for(auto c:counts)res+=c;
+    return res;
+  }
+#endif
+
   hash_strategy hs;
   filter_array  ar;
 };
@@ -0,0 +1,350 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_COUNTER_OPS_HPP
+#define BOOST_BLOOM_DETAIL_COUNTER_OPS_HPP
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/config.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Saturating counters of counting_filter. Each bit of the equivalent filter
+ * array is assigned a counter of CounterBits bits, so the counters for an
+ * array byte take CounterBits bytes, loaded into a Word where the counter of
+ * bit i occupies the i-th CounterBits-wide field. Counters are incremented,
+ * decremented or checked for the bits set in a byte mask as produced by
+ * Subfilter::mark. A counter reaching its maximum value is saturated: its
+ * exact count is lost, so it's never decremented afterwards. Zero counters
+ * are not decremented either.
+ *
+ * The portable implementation processes one mask byte at a time with SWAR
+ * arithmetic on Word, and the AVX2 one processes 4 (8-bit counters) or 8
+ * (4-bit counters) mask bytes at a time, i.e. 32 bytes of counters.
+ */
+
+template<typename Word,std::size_t Bits>
+struct swar_counter_ops
+{
+  static constexpr Word lsb=Word(~Word(0))/Word((Word(1)<<Bits)-1);
+  static constexpr Word msb=Word(lsb<<(Bits-1));
+  static constexpr Word low=Word(msb-lsb);
+
+  /* msb set for the fields with all bits set to one/zero */
+
+  static BOOST_FORCEINLINE Word saturated(Word w)
+  {
+    return Word(((w&low)+lsb)&w&msb);
+  }
+
+  static BOOST_FORCEINLINE Word zero(Word w)
+  {
+    return Word(~(((w&low)+low)|w)&msb);
+  }
+
+  /* e has lsb set for the fields to operate on */
+
+  static BOOST_FORCEINLINE void increment(unsigned char* p,Word e)
+  {
+    Word w=load(p);
+    w+=e&~(saturated(w)>>(Bits-1));
+    std::memcpy(p,&w,sizeof(Word));
+  }
+
+  static BOOST_FORCEINLINE void decrement(unsigned char* p,Word e)
+  {
+    Word w=load(p);
+    w-=e&~((saturated(w)|zero(w))>>(Bits-1));
+    std::memcpy(p,&w,sizeof(Word));
+  }
+
+  static BOOST_FORCEINLINE bool check(const unsigned char* p,Word e)
+  {
+    return !((zero(load(p))>>(Bits-1))&e);
+  }
+
+  static BOOST_FORCEINLINE unsigned char nonzero_mask(const unsigned char* p)
+  {
+    Word          nz=Word(~zero(load(p))&msb);
+    unsigned char res=0;
+    for(std::size_t i=0;i<CHAR_BIT;++i){
+      res|=(unsigned char)(((nz>>(i*Bits+Bits-1))&1u)<<i);
+    }
+    return res;
+  }
+
+  static BOOST_FORCEINLINE Word load(const unsigned char* p)
+  {
+    Word w;
+    std::memcpy(&w,p,sizeof(Word));
+    return w;
+  }
+};
+
+template<std::size_t CounterBits>
+struct counter_ops_base;
+
+template<>
+struct counter_ops_base<8>:swar_counter_ops<std::uint64_t,8>
+{
+  /* bit i of m -> lsb of byte i */
+
+  static BOOST_FORCEINLINE std::uint64_t expand(unsigned char m)
+  {
+    std::uint64_t x=m;
+    x=(x|(x<<28))&0x0000000F0000000Full;
+    x=(x|(x<<14))&0x0003000300030003ull;
+    x=(x|(x<<7)) &0x0101010101010101ull;
+    return x;
+  }
+
+#if defined(BOOST_BLOOM_AVX2)
+  static constexpr std::size_t simd_mask_size=4;
+
+  /* 0xFF for the counters whose mask bit is set, 0 otherwise */
+
+  static BOOST_FORCEINLINE __m256i simd_expand(const unsigned char* m)
+  {
+    std::uint32_t x;
+    std::memcpy(&x,m,sizeof(x));
+    const __m256i shuffle=_mm256_setr_epi8(
+      0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1,
+      2,2,2,2,2,2,2,2,3,3,3,3,3,3,3,3);
+    const __m256i bits=_mm256_set1_epi64x((long long)0x8040201008040201ull);
+    __m256i       v=_mm256_shuffle_epi8(_mm256_set1_epi32((int)x),shuffle);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(v,bits),bits);
+  }
+
+  static BOOST_FORCEINLINE void simd_increment(
+    unsigned char* p,const unsigned char* m)
+  {
+    __m256i c=_mm256_loadu_si256((const __m256i*)p);
+    __m256i e=_mm256_and_si256(simd_expand(m),_mm256_set1_epi8(1));
+    _mm256_storeu_si256((__m256i*)p,_mm256_adds_epu8(c,e));
+  }
+
+  static BOOST_FORCEINLINE void simd_decrement(
+    unsigned char* p,const unsigned char* m)
+  {
+    __m256i c=_mm256_loadu_si256((const __m256i*)p);
+    __m256i e=_mm256_and_si256(simd_expand(m),_mm256_set1_epi8(1));
+    e=_mm256_andnot_si256(_mm256_cmpeq_epi8(c,_mm256_set1_epi8(-1)),e);
+    _mm256_storeu_si256((__m256i*)p,_mm256_subs_epu8(c,e));
+  }
+
+  static BOOST_FORCEINLINE bool simd_check(
+    const unsigned char* p,const unsigned char* m)
+  {
+    __m256i c=_mm256_loadu_si256((const __m256i*)p);
+    __m256i z=_mm256_and_si256(
+      _mm256_cmpeq_epi8(c,_mm256_setzero_si256()),simd_expand(m));
+    return _mm256_testz_si256(z,z);
+  }
+#endif
+};
+
+template<>
+struct counter_ops_base<4>:swar_counter_ops<std::uint32_t,4>
+{
+  /* bit i of m -> lsb of nibble i */
+
+  static BOOST_FORCEINLINE std::uint32_t expand(unsigned char m)
+  {
+    std::uint32_t x=m;
+    x=(x|(x<<12))&0x000F000Fu;
+    x=(x|(x<<6)) &0x03030303u;
+    x=(x|(x<<3)) &0x11111111u;
+    return x;
+  }
+
+#if defined(BOOST_BLOOM_AVX2)
+  static constexpr std::size_t simd_mask_size=8;
+
+  /* Byte i of the result holds the counters of mask bits 2i and 2i+1 in
+   * its low and high nibbles, respectively. simd_expand returns 0x01/0x10
+   * for the nibbles whose mask bit is set, and simd_flags sets 0x01/0x10
+   * for the nibbles equal to the given value (0x0F/0xF0 or zero).
+   */
+
+  static BOOST_FORCEINLINE __m256i simd_expand(const unsigned char* m)
+  {
+    std::uint64_t x;
+    std::memcpy(&x,m,sizeof(x));
+    const __m256i shuffle=_mm256_setr_epi8(
+      0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,
+      4,4,4,4,5,5,5,5,6,6,6,6,7,7,7,7);
+    const __m256i lo_bits=_mm256_set1_epi32(0x40100401);
+    const __m256i hi_bits=_mm256_set1_epi32((int)0x80200802u);
+    __m256i       v=_mm256_shuffle_epi8(
+      _mm256_set1_epi64x((long long)x),shuffle);
+    return _mm256_or_si256(
+      _mm256_and_si256(
+        _mm256_cmpeq_epi8(_mm256_and_si256(v,lo_bits),lo_bits),
+        _mm256_set1_epi8(0x01)),
+      _mm256_and_si256(
+        _mm256_cmpeq_epi8(_mm256_and_si256(v,hi_bits),hi_bits),
+        _mm256_set1_epi8(0x10)));
+  }
+
+  static BOOST_FORCEINLINE __m256i simd_flags(
+    __m256i c,__m256i lo_value,__m256i hi_value)
+  {
+    const __m256i lo_mask=_mm256_set1_epi8(0x0F);
+    const __m256i hi_mask=_mm256_set1_epi8((char)0xF0);
+    return _mm256_or_si256(
+      _mm256_and_si256(
+        _mm256_cmpeq_epi8(_mm256_and_si256(c,lo_mask),lo_value),
+        _mm256_set1_epi8(0x01)),
+      _mm256_and_si256(
+        _mm256_cmpeq_epi8(_mm256_and_si256(c,hi_mask),hi_value),
+        _mm256_set1_epi8(0x10)));
+  }
+
+  static BOOST_FORCEINLINE __m256i simd_saturated(__m256i c)
+  {
+    return simd_flags(
+      c,_mm256_set1_epi8(0x0F),_mm256_set1_epi8((char)0xF0));
+  }
+
+  static BOOST_FORCEINLINE __m256i simd_zero(__m256i c)
+  {
+    return simd_flags(c,_mm256_setzero_si256(),_mm256_setzero_si256());
+  }
+
+  /* byte additions/subtractions don't carry across nibbles as saturated
+   * (zero) nibbles are not incremented (decremented)
+   */
+
+  static BOOST_FORCEINLINE void simd_increment(
+    unsigned char* p,const unsigned char* m)
+  {
+    __m256i c=_mm256_loadu_si256((const __m256i*)p);
+    __m256i e=_mm256_andnot_si256(simd_saturated(c),simd_expand(m));
+    _mm256_storeu_si256((__m256i*)p,_mm256_add_epi8(c,e));
+  }
+
+  static BOOST_FORCEINLINE void simd_decrement(
+    unsigned char* p,const unsigned char* m)
+  {
+    __m256i c=_mm256_loadu_si256((const __m256i*)p);
+    __m256i e=_mm256_andnot_si256(
+      _mm256_or_si256(simd_saturated(c),simd_zero(c)),simd_expand(m));
+    _mm256_storeu_si256((__m256i*)p,_mm256_sub_epi8(c,e));
+  }
+
+  static BOOST_FORCEINLINE bool simd_check(
+    const unsigned char* p,const unsigned char* m)
+  {
+    __m256i c=_mm256_loadu_si256((const __m256i*)p);
+    __m256i z=_mm256_and_si256(simd_zero(c),simd_expand(m));
+    return _mm256_testz_si256(z,z);
+  }
+#endif
+};
+
+template<std::size_t CounterBits>
+struct counter_ops:counter_ops_base<CounterBits>
+{
+  static_assert(
+    CounterBits==4||CounterBits==8,"CounterBits must be 4 or 8");
+
+private:
+  using super=counter_ops_base<CounterBits>;
+
+#if defined(BOOST_BLOOM_AVX2)
+  static constexpr std::size_t simd_mask_size=super::simd_mask_size;
+#else
+  static constexpr std::size_t simd_mask_size=0;
+#endif
+
+  /* number of mask bytes processed with SIMD out of N */
+
+  template<std::size_t N>
+  using simd_size=std::integral_constant<
+    std::size_t,
+    simd_mask_size?N/(simd_mask_size?simd_mask_size:1)*simd_mask_size:0>;
+
+public:
+  /* p points to the counters of the N-byte mask m */
+
+  template<std::size_t N>
+  static BOOST_FORCEINLINE void increment(
+    unsigned char* p,const unsigned char* m)
+  {
+    std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+    for(;i<simd_size<N>::value;i+=simd_mask_size){
+      super::simd_increment(p+i*CounterBits,m+i);
+    }
+#endif
+    for(;i<N;++i){
+      if(m[i])super::increment(p+i*CounterBits,super::expand(m[i]));
+    }
+  }
+
+  template<std::size_t N>
+  static BOOST_FORCEINLINE void decrement(
+    unsigned char* p,const unsigned char* m)
+  {
+    std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+    for(;i<simd_size<N>::value;i+=simd_mask_size){
+      super::simd_decrement(p+i*CounterBits,m+i);
+    }
+#endif
+    for(;i<N;++i){
+      if(m[i])super::decrement(p+i*CounterBits,super::expand(m[i]));
+    }
+  }
+
+  template<std::size_t N>
+  static BOOST_FORCEINLINE bool check(
+    const unsigned char* p,const unsigned char* m)
+  {
+    std::size_t i=0;
+#if defined(BOOST_BLOOM_AVX2)
+    for(;i<simd_size<N>::value;i+=simd_mask_size){
+      if(!super::simd_check(p+i*CounterBits,m+i))return false;
+    }
+#endif
+    for(;i<N;++i){
+      if(m[i]&&!super::check(p+i*CounterBits,super::expand(m[i]))){
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /* array byte with bits set for the nonzero counters pointed to by p */
+
+  static BOOST_FORCEINLINE unsigned char project(const unsigned char* p)
+  {
+    return super::nonzero_mask(p);
+  }
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
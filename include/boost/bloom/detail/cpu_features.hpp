@@ -0,0 +1,134 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_CPU_FEATURES_HPP
+#define BOOST_BLOOM_DETAIL_CPU_FEATURES_HPP
+
+#include <boost/config.hpp>
+#include <cstdint>
+
+/* Runtime dispatch requires that functions for a given instruction set
+ * can be compiled regardless of the compilation flags, which is supported
+ * on x86 by way of target attributes in GCC>=5 and Clang>=5, and natively
+ * in Visual Studio 2017 and later.
+ */
+
+#if !defined(BOOST_BLOOM_DISABLE_RUNTIME_DISPATCH)&&\
+    (defined(__x86_64__)||defined(__i386__)||\
+     defined(_M_X64)||(defined(_M_IX86)&&!defined(_M_ARM64EC)))&&\
+    ((defined(BOOST_GCC)&&BOOST_GCC>=50000)||\
+     (defined(__clang__)&&__clang_major__>=5)||\
+     (defined(BOOST_MSVC)&&BOOST_MSVC>=1910))
+#define BOOST_BLOOM_RUNTIME_DISPATCH
+#endif
+
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+#if defined(BOOST_MSVC)
+#include <immintrin.h>
+#include <intrin.h>
+#define BOOST_BLOOM_TARGET(isa)
+#else
+#include <cpuid.h>
+#include <immintrin.h>
+#define BOOST_BLOOM_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#define BOOST_BLOOM_TARGET_SSE2   BOOST_BLOOM_TARGET("sse2")
+#define BOOST_BLOOM_TARGET_AVX2   BOOST_BLOOM_TARGET("avx2")
+#define BOOST_BLOOM_TARGET_AVX512 BOOST_BLOOM_TARGET("avx2,avx512f,avx512vl")
+#endif
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+enum class simd_level
+{
+  portable=0,
+  sse2,
+  avx2,
+  avx512 /* AVX-512F and AVX-512VL */
+};
+
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline void cpuid(std::uint32_t res[4],std::uint32_t leaf)
+{
+#if defined(BOOST_MSVC)
+  int r[4];
+  __cpuidex(r,(int)leaf,0);
+  for(int i=0;i<4;++i)res[i]=(std::uint32_t)r[i];
+#else
+  unsigned int a,b,c,d;
+  __cpuid_count(leaf,0,a,b,c,d);
+  res[0]=a;
+  res[1]=b;
+  res[2]=c;
+  res[3]=d;
+#endif
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::uint64_t xgetbv0()
+{
+#if defined(BOOST_MSVC)
+  return (std::uint64_t)_xgetbv(0);
+#else
+  std::uint32_t lo,hi;
+  __asm__ __volatile__("xgetbv":"=a"(lo),"=d"(hi):"c"(0));
+  return ((std::uint64_t)hi<<32)|lo;
+#endif
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline simd_level detect_simd_level()
+{
+  std::uint32_t r[4];
+  cpuid(r,0);
+  std::uint32_t max_leaf=r[0];
+  if(max_leaf<1)return simd_level::portable;
+
+  cpuid(r,1);
+  bool sse2=((r[3]>>26)&1u)!=0,
+       osxsave=((r[2]>>27)&1u)!=0,
+       avx=((r[2]>>28)&1u)!=0;
+  if(!sse2)return simd_level::portable;
+  if(!osxsave||!avx||max_leaf<7)return simd_level::sse2;
+
+  std::uint64_t xcr0=xgetbv0();
+  if((xcr0&0x06u)!=0x06u)return simd_level::sse2; /* XMM and YMM state */
+
+  cpuid(r,7);
+  bool avx2=((r[1]>>5)&1u)!=0,
+       avx512f=((r[1]>>16)&1u)!=0,
+       avx512vl=((r[1]>>31)&1u)!=0;
+  if(!avx2)return simd_level::sse2;
+  if(avx512f&&avx512vl&&
+     (xcr0&0xE6u)==0xE6u){ /* also opmask and ZMM state */
+    return simd_level::avx512;
+  }
+  return simd_level::avx2;
+}
+#else
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline simd_level detect_simd_level(){return simd_level::portable;}
+#endif
+
+/* detected only once */
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline simd_level runtime_simd_level()
+{
+  static const simd_level level=detect_simd_level();
+  return level;
+}
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
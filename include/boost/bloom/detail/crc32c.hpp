@@ -0,0 +1,137 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_CRC32C_HPP
+#define BOOST_BLOOM_DETAIL_CRC32C_HPP
+
+#include <boost/bloom/detail/cpu_features.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE4_2__)
+#define BOOST_BLOOM_SSE42
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#define BOOST_BLOOM_ARM_CRC32
+#include <arm_acle.h>
+#endif
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* CRC-32C (Castagnoli polynomial, reflected form 0x82F63B78).
+ * crc32c(crc,p,n) extends the checksum crc of some preceding data with
+ * the n bytes pointed to by p, so that the checksum of a sequence can be
+ * computed chunk by chunk starting with crc=0. The hardware instructions of
+ * SSE4.2 and ARMv8 are used when enabled at compile time; on x86, SSE4.2
+ * is also detected at run time where runtime dispatch is supported (see
+ * cpu_features.hpp).
+ */
+
+struct crc32c_table
+{
+  crc32c_table()
+  {
+    for(std::uint32_t i=0;i<256;++i){
+      std::uint32_t c=i;
+      for(int j=0;j<8;++j)c=(c>>1)^(0x82F63B78u&(0u-(c&1u)));
+      t[i]=c;
+    }
+  }
+
+  std::uint32_t t[256];
+};
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::uint32_t crc32c_portable(
+  std::uint32_t crc,const unsigned char* p,std::size_t n)
+{
+  static const crc32c_table table;
+
+  for(;n;--n)crc=table.t[(crc^*p++)&0xFFu]^(crc>>8);
+  return crc;
+}
+
+#if defined(BOOST_BLOOM_SSE42)||defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+#if !defined(BOOST_BLOOM_SSE42)
+BOOST_BLOOM_TARGET("sse4.2")
+#endif
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::uint32_t crc32c_sse42(
+  std::uint32_t crc,const unsigned char* p,std::size_t n)
+{
+#if defined(__x86_64__)||defined(_M_X64)
+  std::uint64_t c=crc;
+  for(;n>=8;n-=8,p+=8){
+    std::uint64_t x;
+    std::memcpy(&x,p,sizeof(x));
+    c=_mm_crc32_u64(c,x);
+  }
+  crc=(std::uint32_t)c;
+#endif
+  for(;n>=4;n-=4,p+=4){
+    std::uint32_t x;
+    std::memcpy(&x,p,sizeof(x));
+    crc=_mm_crc32_u32(crc,x);
+  }
+  for(;n;--n)crc=_mm_crc32_u8(crc,*p++);
+  return crc;
+}
+#endif
+
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)&&!defined(BOOST_BLOOM_SSE42)
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline bool detect_sse42()
+{
+  std::uint32_t r[4];
+  cpuid(r,0);
+  if(r[0]<1)return false;
+  cpuid(r,1);
+  return ((r[2]>>20)&1u)!=0;
+}
+#endif
+
+#if defined(BOOST_BLOOM_ARM_CRC32)
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::uint32_t crc32c_arm(
+  std::uint32_t crc,const unsigned char* p,std::size_t n)
+{
+  for(;n>=8;n-=8,p+=8){
+    std::uint64_t x;
+    std::memcpy(&x,p,sizeof(x));
+    crc=__crc32cd(crc,x);
+  }
+  for(;n;--n)crc=__crc32cb(crc,*p++);
+  return crc;
+}
+#endif
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::uint32_t crc32c(
+  std::uint32_t crc,const unsigned char* p,std::size_t n)
+{
+  crc=~crc;
+#if defined(BOOST_BLOOM_SSE42)
+  crc=crc32c_sse42(crc,p,n);
+#elif defined(BOOST_BLOOM_ARM_CRC32)
+  crc=crc32c_arm(crc,p,n);
+#elif defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+  static const bool sse42=detect_sse42();
+  crc=sse42?crc32c_sse42(crc,p,n):crc32c_portable(crc,p,n);
+#else
+  crc=crc32c_portable(crc,p,n);
+#endif
+  return ~crc;
+}
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
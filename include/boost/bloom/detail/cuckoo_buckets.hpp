@@ -0,0 +1,166 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_CUCKOO_BUCKETS_HPP
+#define BOOST_BLOOM_DETAIL_CUCKOO_BUCKETS_HPP
+
+#include <boost/bloom/detail/sse2.hpp>
+#include <boost/config.hpp>
+#include <boost/core/bit.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::uint64_t load_le_uint64(const unsigned char* p)noexcept
+{
+  std::uint64_t x;
+  if(boost::core::endian::native==boost::core::endian::little){
+    std::memcpy(&x,p,sizeof(x));
+  }
+  else{
+    x=0;
+    for(int i=7;i>=0;--i)x=(x<<8)|p[i];
+  }
+  return x;
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline void store_le_uint64(unsigned char* p,std::uint64_t x)noexcept
+{
+  if(boost::core::endian::native==boost::core::endian::little){
+    std::memcpy(p,&x,sizeof(x));
+  }
+  else{
+    for(int i=0;i<8;++i,x>>=8)p[i]=(unsigned char)x;
+  }
+}
+
+/* x with n fields of the given width, each set to one */
+
+constexpr std::uint64_t field_pattern(std::size_t width,std::size_t n)
+{
+  return n==0?0:(field_pattern(width,n-1)<<width)|1u;
+}
+
+/* Buckets of cuckoo_filter: BucketSize fingerprints of FingerprintBits bits
+ * each, with buckets packed without padding so that bucket i starts at bit
+ * i*bucket_bits of the array. Bucket contents are read from the
+ * little-endian 64-bit word starting at the bucket's first byte, so the
+ * array is followed by tail_size bytes of padding. Zero denotes an empty
+ * slot.
+ *
+ * Slots are matched against a fingerprint with SWAR (SIMD within a
+ * register) arithmetic on the bucket word, which handles any field width.
+ * The two candidate buckets of an element are probed at once with SSE2,
+ * if available, by applying the same arithmetic to two 64-bit lanes.
+ */
+
+template<std::size_t FingerprintBits,std::size_t BucketSize>
+struct cuckoo_buckets
+{
+  static constexpr std::size_t bucket_bits=FingerprintBits*BucketSize;
+  static_assert(
+    FingerprintBits>=2&&FingerprintBits<=32,
+    "FingerprintBits must be between 2 and 32");
+  static_assert(BucketSize>=1,"BucketSize must be >= 1");
+  static_assert(
+    bucket_bits<=57||(bucket_bits<=64&&bucket_bits%8==0),
+    "FingerprintBits*BucketSize must be <= 57, or <= 64 and a multiple of 8");
+
+  static constexpr std::size_t tail_size=sizeof(std::uint64_t)-1;
+  static constexpr std::uint64_t fingerprint_mask=
+    (std::uint64_t(1)<<FingerprintBits)-1;
+  static constexpr std::uint64_t bucket_mask=
+    bucket_bits==64?~std::uint64_t(0):(std::uint64_t(1)<<bucket_bits)-1;
+  static constexpr std::uint64_t lsb=field_pattern(FingerprintBits,BucketSize);
+  static constexpr std::uint64_t msb=lsb<<(FingerprintBits-1);
+  static constexpr std::uint64_t low=msb-lsb;
+
+  static constexpr std::size_t used_array_size(std::size_t num_buckets)
+  {
+    return (num_buckets*bucket_bits+7)/8;
+  }
+
+  static BOOST_FORCEINLINE std::uint64_t load(
+    const unsigned char* p,std::size_t i)noexcept
+  {
+    std::size_t off=i*bucket_bits;
+    return (load_le_uint64(p+off/8)>>(off%8))&bucket_mask;
+  }
+
+  /* msb set for the fields of bucket word w equal to fp */
+
+  static BOOST_FORCEINLINE std::uint64_t match(
+    std::uint64_t w,std::uint64_t fp)noexcept
+  {
+    std::uint64_t x=w^(lsb*fp);
+    return ~(((x&low)+low)|x)&msb;
+  }
+
+  /* index of a slot of bucket i holding fp, or BucketSize if none */
+
+  static BOOST_FORCEINLINE std::size_t find(
+    const unsigned char* p,std::size_t i,std::uint64_t fp)noexcept
+  {
+    std::uint64_t m=match(load(p,i),fp);
+    return m?(std::size_t)boost::core::countr_zero(m)/FingerprintBits:
+      BucketSize;
+  }
+
+  static BOOST_FORCEINLINE bool contains(
+    const unsigned char* p,std::size_t i1,std::size_t i2,
+    std::uint64_t fp)noexcept
+  {
+#if defined(BOOST_BLOOM_SSE2)
+    __m128i w=_mm_set_epi64x((long long)load(p,i2),(long long)load(p,i1));
+    __m128i x=_mm_xor_si128(w,_mm_set1_epi64x((long long)(lsb*fp)));
+    __m128i l=_mm_set1_epi64x((long long)low);
+    __m128i t=_mm_or_si128(_mm_add_epi64(_mm_and_si128(x,l),l),x);
+    __m128i z=_mm_andnot_si128(t,_mm_set1_epi64x((long long)msb));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(z,_mm_setzero_si128()))!=0xFFFF;
+#else
+    return (match(load(p,i1),fp)|match(load(p,i2),fp))!=0;
+#endif
+  }
+
+  static BOOST_FORCEINLINE std::uint64_t get(
+    const unsigned char* p,std::size_t i,std::size_t j)noexcept
+  {
+    std::size_t off=i*bucket_bits+j*FingerprintBits;
+    return (load_le_uint64(p+off/8)>>(off%8))&fingerprint_mask;
+  }
+
+  static BOOST_FORCEINLINE void set(
+    unsigned char* p,std::size_t i,std::size_t j,std::uint64_t fp)noexcept
+  {
+    std::size_t   off=i*bucket_bits+j*FingerprintBits;
+    std::uint64_t w=load_le_uint64(p+off/8);
+    w&=~(fingerprint_mask<<(off%8));
+    w|=fp<<(off%8);
+    store_le_uint64(p+off/8,w);
+  }
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,213 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_EXTENDED_BLOCK_SIMD_HPP
+#define BOOST_BLOOM_DETAIL_EXTENDED_BLOCK_SIMD_HPP
+
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+#if defined(BOOST_GCC)&&BOOST_GCC>=120000&&BOOST_GCC<130000
+/* false positives on _mm512_undefined_*, see
+ * https://gcc.gnu.org/bugzilla/show_bug.cgi?id=105593
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+/* Register-resident fingerprints for extended blocks Block[N] of 256 or 512
+ * bits with 32- or 64-bit Blocks. set(fp,n) follows the bit arrangement of
+ * block_ops<Block[N]>::set (bit n/N of x[n%N]), so that building the
+ * fingerprint of an operation in registers and then testing or ORing it
+ * against the block in one go yields the same results as the scalar
+ * code. Blocks need not be aligned.
+ *
+ * Only AVX-512 is supported, where setting a bit is a single masked OR of
+ * a broadcast value: with AVX2, selecting the lane of each bit takes
+ * several instructions and the resulting code is slower than scalar.
+ */
+
+template<typename Block,typename=void>
+struct extended_block_simd
+{
+  static constexpr bool enabled=false;
+};
+
+#if defined(BOOST_BLOOM_AVX512)
+template<std::size_t LaneSize>
+struct extended_block_simd_lanes;
+
+template<>
+struct extended_block_simd_lanes<4>
+{
+  static BOOST_FORCEINLINE __m512i mask_or(
+    __m512i x,std::size_t lane,std::uint64_t y)
+  {
+    return _mm512_mask_or_epi32(
+      x,(__mmask16)(1u<<lane),x,_mm512_set1_epi32((int)(std::uint32_t)y));
+  }
+
+  static BOOST_FORCEINLINE __m256i mask_or(
+    __m256i x,std::size_t lane,std::uint64_t y)
+  {
+    return _mm256_mask_or_epi32(
+      x,(__mmask8)(1u<<lane),x,_mm256_set1_epi32((int)(std::uint32_t)y));
+  }
+};
+
+template<>
+struct extended_block_simd_lanes<8>
+{
+  static BOOST_FORCEINLINE __m512i mask_or(
+    __m512i x,std::size_t lane,std::uint64_t y)
+  {
+    return _mm512_mask_or_epi64(
+      x,(__mmask8)(1u<<lane),x,_mm512_set1_epi64((long long)y));
+  }
+
+  static BOOST_FORCEINLINE __m256i mask_or(
+    __m256i x,std::size_t lane,std::uint64_t y)
+  {
+    return _mm256_mask_or_epi64(
+      x,(__mmask8)(1u<<lane),x,_mm256_set1_epi64x((long long)y));
+  }
+};
+
+template<typename Block,std::size_t N,std::size_t Size>
+struct is_extended_block_simd_compatible:std::integral_constant<
+  bool,
+  std::is_unsigned<Block>::value&&
+  (sizeof(Block)==4||sizeof(Block)==8)&&
+  sizeof(Block)*N==Size
+>{};
+
+/* 256-bit blocks */
+
+template<typename Block,std::size_t N>
+struct extended_block_simd<
+  Block[N],
+  typename std::enable_if<
+    is_extended_block_simd_compatible<Block,N,32>::value>::type
+>
+{
+  static constexpr bool enabled=true;
+  using value_type=Block[N];
+  using fingerprint_type=__m256i;
+
+  static BOOST_FORCEINLINE fingerprint_type zero()
+  {
+    return _mm256_setzero_si256();
+  }
+
+  static BOOST_FORCEINLINE void set(fingerprint_type& fp,std::uint64_t n)
+  {
+    fp=lanes::mask_or(fp,n%N,Block(1)<<(n/N));
+  }
+
+  static BOOST_FORCEINLINE bool testc(
+    const value_type& x,const fingerprint_type& fp)
+  {
+    return _mm256_testc_si256(load(x),fp);
+  }
+
+  static BOOST_FORCEINLINE void set_mask(
+    value_type& x,const fingerprint_type& fp)
+  {
+    store(x,_mm256_or_si256(load(x),fp));
+  }
+
+private:
+  using lanes=extended_block_simd_lanes<sizeof(Block)>;
+
+  static BOOST_FORCEINLINE __m256i load(const value_type& x)
+  {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x));
+  }
+
+  static BOOST_FORCEINLINE void store(value_type& x,__m256i y)
+  {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(x),y);
+  }
+};
+
+/* 512-bit blocks */
+
+template<typename Block,std::size_t N>
+struct extended_block_simd<
+  Block[N],
+  typename std::enable_if<
+    is_extended_block_simd_compatible<Block,N,64>::value>::type
+>
+{
+  static constexpr bool enabled=true;
+  using value_type=Block[N];
+  using fingerprint_type=__m512i;
+
+  static BOOST_FORCEINLINE fingerprint_type zero()
+  {
+    return _mm512_setzero_si512();
+  }
+
+  static BOOST_FORCEINLINE void set(fingerprint_type& fp,std::uint64_t n)
+  {
+    fp=lanes::mask_or(fp,n%N,Block(1)<<(n/N));
+  }
+
+  static BOOST_FORCEINLINE bool testc(
+    const value_type& x,const fingerprint_type& fp)
+  {
+    __m512i d=_mm512_andnot_si512(load(x),fp); /* bits in fp not in x */
+    return _mm512_test_epi64_mask(d,d)==0;
+  }
+
+  static BOOST_FORCEINLINE void set_mask(
+    value_type& x,const fingerprint_type& fp)
+  {
+    store(x,_mm512_or_si512(load(x),fp));
+  }
+
+private:
+  using lanes=extended_block_simd_lanes<sizeof(Block)>;
+
+  static BOOST_FORCEINLINE __m512i load(const value_type& x)
+  {
+    return _mm512_loadu_si512(reinterpret_cast<const void*>(x));
+  }
+
+  static BOOST_FORCEINLINE void store(value_type& x,__m512i y)
+  {
+    _mm512_storeu_si512(reinterpret_cast<void*>(x),y);
+  }
+};
+#endif
+
+#if defined(BOOST_GCC)&&BOOST_GCC>=120000&&BOOST_GCC<130000
+#pragma GCC diagnostic pop /* -W(maybe-)uninitialized */
+#endif
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -55,6 +55,19 @@ struct fast_multiblock32:detail::multiblock_fpr_base<K>
     return true;
   }
 
+  static BOOST_FORCEINLINE bool try_mark(value_type& x,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<k/8;++i){
+      res|=try_mark_m256i(x[i],hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8){
+      res|=try_mark_m256i(x[k/8],hash,k%8);
+    }
+    return res;
+  }
+
 private:
   static BOOST_FORCEINLINE __m256i make_m256i(
     std::uint64_t hash,std::size_t kp)
@@ -96,6 +109,15 @@ private:
     return _mm256_testc_si256(x,h);
   }
 
+  static BOOST_FORCEINLINE bool try_mark_m256i(
+    __m256i& x,std::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=make_m256i(hash,kp);
+    bool    res=!_mm256_testc_si256(x,h);
+    x=_mm256_or_si256(x,h);
+    return res;
+  }
+
 #if BOOST_WORKAROUND(BOOST_MSVC,<=1900)
 #pragma warning(pop) /* C4800 */
 #endif
@@ -0,0 +1,183 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK32_AVX512_HPP
+#define BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK32_AVX512_HPP
+
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/multiblock_fpr_base.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+#if defined(BOOST_GCC)&&BOOST_GCC>=120000&&BOOST_GCC<130000
+/* false positives on _mm512_undefined_*, see
+ * https://gcc.gnu.org/bugzilla/show_bug.cgi?id=105593
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+/* The layout of value_type is the same as in the AVX2 implementation (see
+ * fast_multiblock32_avx2.hpp), and lanes are set exactly as there, so that
+ * the resulting filter array is the same for both. Pairs of consecutive
+ * __m256i's are processed as a single __m512i, and a trailing __m256i,
+ * if any, is processed with 256-bit masked instructions.
+ */
+
+template<std::size_t K>
+struct fast_multiblock32:detail::multiblock_fpr_base<K>
+{
+  static constexpr std::size_t k=K;
+  using value_type=__m256i[(k+7)/8];
+  static constexpr std::size_t used_value_size=sizeof(std::uint32_t)*k;
+
+  static BOOST_FORCEINLINE void mark(value_type& x,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/16;++i){
+      mark_m512i(&x[2*i],hash,16);
+    }
+    if(k%16>8){
+      mark_m512i(&x[2*(k/16)],hash,k%16);
+    }
+    else if(k%16){
+      mark_m256i(x[2*(k/16)],hash,k%16);
+    }
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/16;++i){
+      if(!check_m512i(&x[2*i],hash,16))return false;
+    }
+    if(k%16>8){
+      return check_m512i(&x[2*(k/16)],hash,k%16);
+    }
+    else if(k%16){
+      return check_m256i(x[2*(k/16)],hash,k%16);
+    }
+    return true;
+  }
+
+  static BOOST_FORCEINLINE bool try_mark(value_type& x,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<k/16;++i){
+      res|=try_mark_m512i(&x[2*i],hash,16);
+    }
+    if(k%16>8){
+      res|=try_mark_m512i(&x[2*(k/16)],hash,k%16);
+    }
+    else if(k%16){
+      res|=try_mark_m256i(x[2*(k/16)],hash,k%16);
+    }
+    return res;
+  }
+
+private:
+  /* advances hash past the two groups of 8 lanes */
+
+  static BOOST_FORCEINLINE __m512i make_m512i(
+    std::uint64_t& hash,std::size_t kp)
+  {
+    std::uint64_t hash0=hash,
+                  hash1=detail::mulx64(hash0);
+    hash=detail::mulx64(hash1);
+
+    __m512i h=_mm512_inserti64x4(
+      _mm512_castsi256_si512(_mm256_set1_epi64x((long long)hash0)),
+      _mm256_set1_epi64x((long long)hash1),1);
+    h=_mm512_sllv_epi64(h,_mm512_set_epi64(15,10,5,0,15,10,5,0));
+    h=_mm512_srli_epi32(h,32-5);
+    return _mm512_maskz_sllv_epi32(
+      (__mmask16)((1u<<kp)-1),_mm512_set1_epi32(1),h);
+  }
+
+  static BOOST_FORCEINLINE __m256i make_m256i(
+    std::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=_mm256_set1_epi64x((long long)hash);
+    h=_mm256_sllv_epi64(h,_mm256_set_epi64x(15,10,5,0));
+    h=_mm256_srli_epi32(h,32-5);
+    return _mm256_maskz_sllv_epi32(
+      (__mmask8)((1u<<kp)-1),_mm256_set1_epi32(1),h);
+  }
+
+  static BOOST_FORCEINLINE void mark_m512i(
+    __m256i* p,std::uint64_t& hash,std::size_t kp)
+  {
+    __m512i h=make_m512i(hash,kp);
+    _mm512_storeu_si512(
+      (void*)p,_mm512_or_si512(_mm512_loadu_si512((const void*)p),h));
+  }
+
+  static BOOST_FORCEINLINE bool check_m512i(
+    const __m256i* p,std::uint64_t& hash,std::size_t kp)
+  {
+    __m512i h=make_m512i(hash,kp);
+    __m512i m=_mm512_andnot_si512( /* bits of h not in x */
+      _mm512_loadu_si512((const void*)p),h);
+    return _mm512_test_epi32_mask(m,m)==0;
+  }
+
+  static BOOST_FORCEINLINE bool try_mark_m512i(
+    __m256i* p,std::uint64_t& hash,std::size_t kp)
+  {
+    __m512i h=make_m512i(hash,kp);
+    __m512i x=_mm512_loadu_si512((const void*)p);
+    __m512i m=_mm512_andnot_si512(x,h);
+    _mm512_storeu_si512((void*)p,_mm512_or_si512(x,h));
+    return _mm512_test_epi32_mask(m,m)!=0;
+  }
+
+  static BOOST_FORCEINLINE void mark_m256i(
+    __m256i& x,std::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=make_m256i(hash,kp);
+    x=_mm256_or_si256(x,h);
+  }
+
+  static BOOST_FORCEINLINE bool check_m256i(
+    const __m256i& x,std::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=make_m256i(hash,kp);
+    return _mm256_testc_si256(x,h)!=0;
+  }
+
+  static BOOST_FORCEINLINE bool try_mark_m256i(
+    __m256i& x,std::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=make_m256i(hash,kp);
+    bool    res=_mm256_testc_si256(x,h)==0;
+    x=_mm256_or_si256(x,h);
+    return res;
+  }
+};
+
+#if defined(BOOST_GCC)&&BOOST_GCC>=120000&&BOOST_GCC<130000
+#pragma GCC diagnostic pop /* -W[maybe-]uninitialized */
+#endif
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+
+#endif
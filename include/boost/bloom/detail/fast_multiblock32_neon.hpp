@@ -68,6 +68,19 @@ struct fast_multiblock32:detail::multiblock_fpr_base<K>
     return true;
   }
 
+  static BOOST_FORCEINLINE bool try_mark(value_type& x,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<k/8;++i){
+      res|=try_mark_uint32x4x2_t(x[i],hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8){
+      res|=try_mark_uint32x4x2_t(x[k/8],hash,k%8);
+    }
+    return res;
+  }
+
 private:
   static BOOST_FORCEINLINE uint32x4x2_t make_uint32x4x2_t(
     std::uint64_t hash,std::size_t kp)
@@ -131,6 +144,18 @@ private:
     int64x2_t res=vreinterpretq_s64_u32(vandq_u32(lo,hi));
     return (vgetq_lane_s64(res,0)&vgetq_lane_s64(res,1))==-1;
   }
+
+  static BOOST_FORCEINLINE bool try_mark_uint32x4x2_t(
+    uint32x4x2_t& x,std::uint64_t hash,std::size_t kp)
+  {
+    uint32x4x2_t h=make_uint32x4x2_t(hash,kp);
+    /* bits newly set are those in h but not in x */
+    uint64x2_t   res=vreinterpretq_u64_u32(vorrq_u32(
+      vbicq_u32(h.val[0],x.val[0]),vbicq_u32(h.val[1],x.val[1])));
+    x.val[0]=vorrq_u32(x.val[0],h.val[0]);
+    x.val[1]=vorrq_u32(x.val[1],h.val[1]);
+    return (vgetq_lane_u64(res,0)|vgetq_lane_u64(res,1))!=0;
+  }
 };
 
 #undef BOOST_BLOOM_INIT_U32X4X2
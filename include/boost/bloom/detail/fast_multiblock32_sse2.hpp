@@ -78,6 +78,19 @@ struct fast_multiblock32:detail::multiblock_fpr_base<K>
     return true;
   }
 
+  static BOOST_FORCEINLINE bool try_mark(value_type& x,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<k/8;++i){
+      res|=try_mark_m128ix2(x[i],hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8){
+      res|=try_mark_m128ix2(x[k/8],hash,k%8);
+    }
+    return res;
+  }
+
 private:
   static BOOST_FORCEINLINE detail::m128ix2 make_m128ix2(
     std::uint64_t hash,std::size_t kp)
@@ -137,6 +150,19 @@ private:
     return res;
   }
 
+  static BOOST_FORCEINLINE bool try_mark_m128ix2(
+    detail::m128ix2& x,std::uint64_t hash,std::size_t kp)
+  {
+    detail::m128ix2 h=make_m128ix2(hash,kp);
+    auto            res=detail::mm_testc_si128(x.lo,h.lo);
+    x.lo=_mm_or_si128(x.lo,h.lo);
+    if(kp>4){
+      res&=detail::mm_testc_si128(x.hi,h.hi);
+      x.hi=_mm_or_si128(x.hi,h.hi);
+    }
+    return !res;
+  }
+
 #if BOOST_WORKAROUND(BOOST_MSVC,<=1900)
 #pragma warning(pop) /* C4800 */
 #endif
@@ -0,0 +1,135 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK64_AVX512_HPP
+#define BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK64_AVX512_HPP
+
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/multiblock_fpr_base.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+#if defined(BOOST_GCC)&&BOOST_GCC>=120000&&BOOST_GCC<130000
+/* false positives on _mm512_undefined_*, see
+ * https://gcc.gnu.org/bugzilla/show_bug.cgi?id=105593
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+/* The layout of value_type is the same as in the AVX2 implementation (see
+ * fast_multiblock64_avx2.hpp), where each group of 8 64-bit lanes is
+ * stored as a pair of __m256i's, and lanes are set exactly as there, so
+ * that the resulting filter array is the same for both.
+ */
+
+template<std::size_t K>
+struct fast_multiblock64:detail::multiblock_fpr_base<K>
+{
+  static constexpr std::size_t k=K;
+  using value_type=__m256i[2*((k+7)/8)];
+  static constexpr std::size_t used_value_size=sizeof(std::uint64_t)*k;
+
+  static BOOST_FORCEINLINE void mark(value_type& x,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      mark_m512i(&x[2*i],hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8){
+      mark_m512i(&x[2*(k/8)],hash,k%8);
+    }
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      if(!check_m512i(&x[2*i],hash,8))return false;
+      hash=detail::mulx64(hash);
+    }
+    if(k%8){
+      if(!check_m512i(&x[2*(k/8)],hash,k%8))return false;
+    }
+    return true;
+  }
+
+  static BOOST_FORCEINLINE bool try_mark(value_type& x,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<k/8;++i){
+      res|=try_mark_m512i(&x[2*i],hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8){
+      res|=try_mark_m512i(&x[2*(k/8)],hash,k%8);
+    }
+    return res;
+  }
+
+private:
+  static BOOST_FORCEINLINE __m512i make_m512i(
+    std::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=_mm256_set1_epi64x((long long)hash);
+    h=_mm256_sllv_epi64(h,_mm256_set_epi64x(18,12,6,0));
+    h=_mm256_srli_epi32(h,32-6);
+    return _mm512_maskz_sllv_epi64(
+      (__mmask8)((1u<<kp)-1),_mm512_set1_epi64(1),_mm512_cvtepu32_epi64(h));
+  }
+
+  static BOOST_FORCEINLINE void mark_m512i(
+    __m256i* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m512i h=make_m512i(hash,kp);
+    _mm512_storeu_si512(
+      (void*)p,_mm512_or_si512(_mm512_loadu_si512((const void*)p),h));
+  }
+
+  static BOOST_FORCEINLINE bool check_m512i(
+    const __m256i* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m512i h=make_m512i(hash,kp);
+    __m512i m=_mm512_andnot_si512( /* bits of h not in x */
+      _mm512_loadu_si512((const void*)p),h);
+    return _mm512_test_epi64_mask(m,m)==0;
+  }
+
+  static BOOST_FORCEINLINE bool try_mark_m512i(
+    __m256i* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m512i h=make_m512i(hash,kp);
+    __m512i x=_mm512_loadu_si512((const void*)p);
+    __m512i m=_mm512_andnot_si512(x,h);
+    _mm512_storeu_si512((void*)p,_mm512_or_si512(x,h));
+    return _mm512_test_epi64_mask(m,m)!=0;
+  }
+};
+
+#if defined(BOOST_GCC)&&BOOST_GCC>=120000&&BOOST_GCC<130000
+#pragma GCC diagnostic pop /* -W[maybe-]uninitialized */
+#endif
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+
+#endif
@@ -0,0 +1,154 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK64_NEON_HPP
+#define BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK64_NEON_HPP
+
+#include <boost/bloom/detail/multiblock_fpr_base.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/bloom/detail/neon.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+#define BOOST_BLOOM_INIT_U64X2X4(a0,a1,b0,b1,c0,c1,d0,d1) \
+{{{a0,a1},{b0,b1},{c0,c1},{d0,d1}}}
+
+/* Same bit mapping as fast_multiblock64_avx2.hpp: lane 2j (resp. 2j+1) of
+ * a group of 8 gets bit number low32(h<<(6*j))>>26
+ * (resp. high32(h<<(6*j))>>26), which is calculated here as
+ * (h<<(6*j+32))>>58 (resp. (h<<(6*j))>>58) with uint64x2_t lanes.
+ */
+
+template<std::size_t K>
+struct fast_multiblock64:detail::multiblock_fpr_base<K>
+{
+  static constexpr std::size_t k=K;
+  using value_type=uint64x2x4_t[(k+7)/8];
+  static constexpr std::size_t used_value_size=sizeof(std::uint64_t)*k;
+
+  static BOOST_FORCEINLINE void mark(value_type& x,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      mark_uint64x2x4_t(x[i],hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8){
+      mark_uint64x2x4_t(x[k/8],hash,k%8);
+    }
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      if(!check_uint64x2x4_t(x[i],hash,8))return false;
+      hash=detail::mulx64(hash);
+    }
+    if(k%8){
+      if(!check_uint64x2x4_t(x[k/8],hash,k%8))return false;
+    }
+    return true;
+  }
+
+  static BOOST_FORCEINLINE bool try_mark(value_type& x,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<k/8;++i){
+      res|=try_mark_uint64x2x4_t(x[i],hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8){
+      res|=try_mark_uint64x2x4_t(x[k/8],hash,k%8);
+    }
+    return res;
+  }
+
+private:
+  static BOOST_FORCEINLINE uint64x2x4_t make_uint64x2x4_t(
+    std::uint64_t hash,std::size_t kp)
+  {
+    static const uint64x2x4_t ones[8]={
+      BOOST_BLOOM_INIT_U64X2X4(1,0,0,0,0,0,0,0),
+      BOOST_BLOOM_INIT_U64X2X4(1,1,0,0,0,0,0,0),
+      BOOST_BLOOM_INIT_U64X2X4(1,1,1,0,0,0,0,0),
+      BOOST_BLOOM_INIT_U64X2X4(1,1,1,1,0,0,0,0),
+      BOOST_BLOOM_INIT_U64X2X4(1,1,1,1,1,0,0,0),
+      BOOST_BLOOM_INIT_U64X2X4(1,1,1,1,1,1,0,0),
+      BOOST_BLOOM_INIT_U64X2X4(1,1,1,1,1,1,1,0),
+      BOOST_BLOOM_INIT_U64X2X4(1,1,1,1,1,1,1,1)
+    };
+
+    uint64x2_t h=vdupq_n_u64(hash);
+    uint64x2_t h0=vshrq_n_u64(vshlq_u64(h,(int64x2_t{32, 0})),64-6),
+               h1=vshrq_n_u64(vshlq_u64(h,(int64x2_t{38, 6})),64-6),
+               h2=vshrq_n_u64(vshlq_u64(h,(int64x2_t{44,12})),64-6),
+               h3=vshrq_n_u64(vshlq_u64(h,(int64x2_t{50,18})),64-6);
+
+    return {{
+      vshlq_u64(ones[kp-1].val[0],vreinterpretq_s64_u64(h0)),
+      vshlq_u64(ones[kp-1].val[1],vreinterpretq_s64_u64(h1)),
+      vshlq_u64(ones[kp-1].val[2],vreinterpretq_s64_u64(h2)),
+      vshlq_u64(ones[kp-1].val[3],vreinterpretq_s64_u64(h3))
+    }};
+  }
+
+  static BOOST_FORCEINLINE void mark_uint64x2x4_t(
+    uint64x2x4_t& x,std::uint64_t hash,std::size_t kp)
+  {
+    uint64x2x4_t h=make_uint64x2x4_t(hash,kp);
+    x.val[0]=vorrq_u64(x.val[0],h.val[0]);
+    x.val[1]=vorrq_u64(x.val[1],h.val[1]);
+    x.val[2]=vorrq_u64(x.val[2],h.val[2]);
+    x.val[3]=vorrq_u64(x.val[3],h.val[3]);
+  }
+
+  static BOOST_FORCEINLINE bool check_uint64x2x4_t(
+    const uint64x2x4_t& x,std::uint64_t hash,std::size_t kp)
+  {
+    uint64x2x4_t h=make_uint64x2x4_t(hash,kp);
+    /* bits in h not in x (unused lanes in h are zero) */
+    uint64x2_t   res=vorrq_u64(
+      vorrq_u64(vbicq_u64(h.val[0],x.val[0]),vbicq_u64(h.val[1],x.val[1])),
+      vorrq_u64(vbicq_u64(h.val[2],x.val[2]),vbicq_u64(h.val[3],x.val[3])));
+    return (vgetq_lane_u64(res,0)|vgetq_lane_u64(res,1))==0;
+  }
+
+  static BOOST_FORCEINLINE bool try_mark_uint64x2x4_t(
+    uint64x2x4_t& x,std::uint64_t hash,std::size_t kp)
+  {
+    uint64x2x4_t h=make_uint64x2x4_t(hash,kp);
+    /* bits newly set are those in h but not in x */
+    uint64x2_t   res=vorrq_u64(
+      vorrq_u64(vbicq_u64(h.val[0],x.val[0]),vbicq_u64(h.val[1],x.val[1])),
+      vorrq_u64(vbicq_u64(h.val[2],x.val[2]),vbicq_u64(h.val[3],x.val[3])));
+    x.val[0]=vorrq_u64(x.val[0],h.val[0]);
+    x.val[1]=vorrq_u64(x.val[1],h.val[1]);
+    x.val[2]=vorrq_u64(x.val[2],h.val[2]);
+    x.val[3]=vorrq_u64(x.val[3],h.val[3]);
+    return (vgetq_lane_u64(res,0)|vgetq_lane_u64(res,1))!=0;
+  }
+};
+
+#undef BOOST_BLOOM_INIT_U64X2X4
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+
+#endif
@@ -0,0 +1,125 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK64_PORTABLE_HPP
+#define BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK64_PORTABLE_HPP
+
+#include <boost/bloom/detail/multiblock_fpr_base.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/config.hpp>
+#include <boost/core/bit.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+/* Non-SIMD implementation reproducing the bit mapping of
+ * fast_multiblock64_avx2.hpp, so that filter arrays are interchangeable
+ * between hosts with and without AVX2: lanes are processed in groups of 8,
+ * with lane 2j (resp. 2j+1) of a group getting bit number
+ * low32(h<<(6*j))>>26 (resp. high32(h<<(6*j))>>26), and h rehashed with
+ * mulx64 for every new group. On big-endian platforms, bit numbers are
+ * adjusted so that the resulting memory contents are the same as in
+ * little-endian ones.
+ */
+
+template<std::size_t K>
+struct fast_multiblock64:detail::multiblock_fpr_base<K>
+{
+  static constexpr std::size_t k=K;
+  using value_type=std::uint64_t[8*((k+7)/8)];
+  static constexpr std::size_t used_value_size=sizeof(std::uint64_t)*k;
+
+  static BOOST_FORCEINLINE void mark(value_type& x,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      mark_group(x+8*i,hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8){
+      mark_group(x+8*(k/8),hash,k%8);
+    }
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      if(!check_group(x+8*i,hash,8))return false;
+      hash=detail::mulx64(hash);
+    }
+    if(k%8){
+      if(!check_group(x+8*(k/8),hash,k%8))return false;
+    }
+    return true;
+  }
+
+  static BOOST_FORCEINLINE bool try_mark(value_type& x,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<k/8;++i){
+      res|=try_mark_group(x+8*i,hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8){
+      res|=try_mark_group(x+8*(k/8),hash,k%8);
+    }
+    return res;
+  }
+
+private:
+  static BOOST_FORCEINLINE unsigned int lane_bit(
+    std::uint64_t hash,std::size_t j)
+  {
+    /* low32(hash<<(6*j'))>>26 for j=2j', high32(hash<<(6*j'))>>26 for j=2j'+1 */
+    unsigned int n=(unsigned int)(hash>>((j%2?58:26)-6*(j/2)))&63u;
+    if(boost::core::endian::native==boost::core::endian::big){
+      n^=56; /* byte n/8 -> byte 7-n/8 */
+    }
+    return n;
+  }
+
+  static BOOST_FORCEINLINE void mark_group(
+    std::uint64_t* p,std::uint64_t hash,std::size_t kp)
+  {
+    for(std::size_t j=0;j<kp;++j)p[j]|=(std::uint64_t)1<<lane_bit(hash,j);
+  }
+
+  static BOOST_FORCEINLINE bool check_group(
+    const std::uint64_t* p,std::uint64_t hash,std::size_t kp)
+  {
+    std::uint64_t res=1;
+    for(std::size_t j=0;j<kp;++j)res&=p[j]>>lane_bit(hash,j);
+    return res&1;
+  }
+
+  static BOOST_FORCEINLINE bool try_mark_group(
+    std::uint64_t* p,std::uint64_t hash,std::size_t kp)
+  {
+    std::uint64_t res=0;
+    for(std::size_t j=0;j<kp;++j){
+      std::uint64_t m=(std::uint64_t)1<<lane_bit(hash,j);
+      res|=~p[j]&m;
+      p[j]|=m;
+    }
+    return res!=0;
+  }
+};
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
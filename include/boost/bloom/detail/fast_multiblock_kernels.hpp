@@ -0,0 +1,685 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK_KERNELS_HPP
+#define BOOST_BLOOM_DETAIL_FAST_MULTIBLOCK_KERNELS_HPP
+
+#include <boost/bloom/detail/cpu_features.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+#if defined(BOOST_MSVC)
+#pragma warning(push)
+#pragma warning(disable:4714) /* marked as __forceinline not inlined */
+#endif
+
+#if defined(BOOST_GCC)&&BOOST_GCC>=120000&&BOOST_GCC<130000
+/* false positives on _mm512_undefined_*, see
+ * https://gcc.gnu.org/bugzilla/show_bug.cgi?id=105593
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+/* Kernels for fast_multiblock32/64 operating on raw memory and reproducing
+ * the bit mapping of their AVX2 implementations (fast_multiblock32_avx2.hpp,
+ * fast_multiblock64_avx2.hpp) for all instruction sets:
+ *
+ *   - Bits are set in groups of 8 lanes, each group using a different hash
+ *     value h_0=hash, h_{i+1}=mulx64(h_i).
+ *   - For fast_multiblock32, lane 2j (resp. 2j+1) of a group gets bit number
+ *     low32(h<<(5*j))>>27 (resp. high32(h<<(5*j))>>27).
+ *   - For fast_multiblock64, the same applies with 6 instead of 5 and 26
+ *     instead of 27.
+ *
+ * The portable versions work bytewise so as to produce the same memory
+ * contents on little- and big-endian platforms. SIMD versions are compiled
+ * with target attributes so that they can be selected at run time
+ * regardless of compilation flags.
+ */
+
+struct fast_multiblock_kernel_table
+{
+  void (*mark)(unsigned char*,std::uint64_t);
+  bool (*check)(const unsigned char*,std::uint64_t);
+  bool (*try_mark)(unsigned char*,std::uint64_t);
+
+  /* Block windows of filter's bulk operations (see bulk_kernels in
+   * detail/core.hpp): a window is processed with one indirect call and
+   * the block kernels inlined.
+   */
+
+  void (*mark_blocks)(
+    unsigned char* const*,const std::uint64_t*,std::size_t);
+  void (*check_blocks)(
+    const unsigned char* const*,const std::uint64_t*,std::size_t,bool*);
+};
+
+/* Window kernels for an instruction set, defined with the same target
+ * attributes as the block kernels they call so that these get inlined.
+ */
+
+#define BOOST_BLOOM_FAST_MULTIBLOCK_WINDOW_KERNELS(target,suffix)         \
+  target static void mark_blocks_##suffix(                                \
+    unsigned char* const* ps,const std::uint64_t* hashes,std::size_t n)   \
+  {                                                                       \
+    for(std::size_t i=0;i<n;++i)mark_##suffix(ps[i],hashes[i]);           \
+  }                                                                       \
+                                                                          \
+  target static void check_blocks_##suffix(                               \
+    const unsigned char* const* ps,const std::uint64_t* hashes,           \
+    std::size_t n,bool* res)                                              \
+  {                                                                       \
+    for(std::size_t i=0;i<n;++i)res[i]&=check_##suffix(ps[i],hashes[i]);  \
+  }
+
+template<std::size_t LaneSize>
+struct fast_multiblock_portable_kernels
+{
+  static constexpr int lane_bits=LaneSize==4?5:6;
+
+  static BOOST_FORCEINLINE std::size_t bit_for_lane(
+    std::uint64_t hash,std::size_t i)
+  {
+    std::uint64_t h=hash<<(lane_bits*(i/2));
+    if(i%2)h>>=32;
+    return (std::size_t)((std::uint32_t)h>>(32-lane_bits));
+  }
+
+  template<std::size_t K>
+  static void mark(unsigned char* p,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<K;++i){
+      if(i&&i%8==0)hash=detail::mulx64(hash);
+      std::size_t n=bit_for_lane(hash,i%8);
+      p[LaneSize*i+n/8]|=(unsigned char)(1u<<(n%8));
+    }
+  }
+
+  template<std::size_t K>
+  static bool check(const unsigned char* p,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<K;++i){
+      if(i&&i%8==0)hash=detail::mulx64(hash);
+      std::size_t n=bit_for_lane(hash,i%8);
+      if(!(p[LaneSize*i+n/8]&(1u<<(n%8))))return false;
+    }
+    return true;
+  }
+
+  template<std::size_t K>
+  static bool try_mark(unsigned char* p,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<K;++i){
+      if(i&&i%8==0)hash=detail::mulx64(hash);
+      std::size_t   n=bit_for_lane(hash,i%8);
+      unsigned char m=(unsigned char)(1u<<(n%8));
+      res|=!(p[LaneSize*i+n/8]&m);
+      p[LaneSize*i+n/8]|=m;
+    }
+    return res;
+  }
+};
+
+template<std::size_t K>
+struct fast_multiblock32_kernels
+{
+  static constexpr std::size_t k=K;
+  using portable=fast_multiblock_portable_kernels<4>;
+
+  static void mark_portable(unsigned char* p,std::uint64_t hash)
+  {
+    portable::template mark<k>(p,hash);
+  }
+
+  static bool check_portable(const unsigned char* p,std::uint64_t hash)
+  {
+    return portable::template check<k>(p,hash);
+  }
+
+  static bool try_mark_portable(unsigned char* p,std::uint64_t hash)
+  {
+    return portable::template try_mark<k>(p,hash);
+  }
+
+  BOOST_BLOOM_FAST_MULTIBLOCK_WINDOW_KERNELS(,portable)
+
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+  /* SSE2: lanes are calculated as 2^x by way of float conversion, see
+   * fast_multiblock32_sse2.hpp.
+   */
+
+  BOOST_BLOOM_TARGET_SSE2 static BOOST_FORCEINLINE void make_sse2(
+    std::uint64_t hash,std::size_t kp,__m128i& lo,__m128i& hi)
+  {
+    const __m128i mask=_mm_set1_epi32(31<<23),
+                  exp=_mm_set1_epi32(127<<23),
+                  n=_mm_set1_epi32((int)kp);
+
+    __m128i h_lo=_mm_set_epi64x((long long)(hash<<5),(long long)hash),
+            h_hi=_mm_set_epi64x((long long)(hash<<15),(long long)(hash<<10));
+    h_lo=_mm_and_si128(_mm_srli_epi32(h_lo,27-23),mask);
+    h_hi=_mm_and_si128(_mm_srli_epi32(h_hi,27-23),mask);
+    h_lo=_mm_add_epi32(h_lo,_mm_and_si128(
+      _mm_cmplt_epi32(_mm_set_epi32(3,2,1,0),n),exp));
+    h_hi=_mm_add_epi32(h_hi,_mm_and_si128(
+      _mm_cmplt_epi32(_mm_set_epi32(7,6,5,4),n),exp));
+    lo=_mm_cvttps_epi32(_mm_castsi128_ps(h_lo));
+    hi=_mm_cvttps_epi32(_mm_castsi128_ps(h_hi));
+  }
+
+  BOOST_BLOOM_TARGET_SSE2 static BOOST_FORCEINLINE bool testc_sse2(
+    __m128i x,__m128i y)
+  {
+    return _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(x,y),y))==0xFFFF;
+  }
+
+  BOOST_BLOOM_TARGET_SSE2 static BOOST_FORCEINLINE void mark_sse2(
+    unsigned char* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m128i lo,hi;
+    make_sse2(hash,kp,lo,hi);
+    _mm_storeu_si128(
+      (__m128i*)p,_mm_or_si128(_mm_loadu_si128((const __m128i*)p),lo));
+    if(kp>4){
+      _mm_storeu_si128(
+        (__m128i*)(p+16),
+        _mm_or_si128(_mm_loadu_si128((const __m128i*)(p+16)),hi));
+    }
+  }
+
+  BOOST_BLOOM_TARGET_SSE2 static BOOST_FORCEINLINE bool check_sse2(
+    const unsigned char* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m128i lo,hi;
+    make_sse2(hash,kp,lo,hi);
+    return
+      testc_sse2(_mm_loadu_si128((const __m128i*)p),lo)&&
+      (kp<=4||testc_sse2(_mm_loadu_si128((const __m128i*)(p+16)),hi));
+  }
+
+  BOOST_BLOOM_TARGET_SSE2 static BOOST_FORCEINLINE bool try_mark_sse2(
+    unsigned char* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m128i lo,hi;
+    make_sse2(hash,kp,lo,hi);
+    __m128i x=_mm_loadu_si128((const __m128i*)p);
+    bool    res=!testc_sse2(x,lo);
+    _mm_storeu_si128((__m128i*)p,_mm_or_si128(x,lo));
+    if(kp>4){
+      x=_mm_loadu_si128((const __m128i*)(p+16));
+      res|=!testc_sse2(x,hi);
+      _mm_storeu_si128((__m128i*)(p+16),_mm_or_si128(x,hi));
+    }
+    return res;
+  }
+
+  BOOST_BLOOM_TARGET_SSE2 static void mark_sse2(
+    unsigned char* p,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      mark_sse2(p+32*i,hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8)mark_sse2(p+32*(k/8),hash,k%8);
+  }
+
+  BOOST_BLOOM_TARGET_SSE2 static bool check_sse2(
+    const unsigned char* p,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      if(!check_sse2(p+32*i,hash,8))return false;
+      hash=detail::mulx64(hash);
+    }
+    return k%8==0||check_sse2(p+32*(k/8),hash,k%8);
+  }
+
+  BOOST_BLOOM_TARGET_SSE2 static bool try_mark_sse2(
+    unsigned char* p,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<k/8;++i){
+      res|=try_mark_sse2(p+32*i,hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8)res|=try_mark_sse2(p+32*(k/8),hash,k%8);
+    return res;
+  }
+
+  BOOST_BLOOM_FAST_MULTIBLOCK_WINDOW_KERNELS(BOOST_BLOOM_TARGET_SSE2,sse2)
+
+  /* AVX2 */
+
+  BOOST_BLOOM_TARGET_AVX2 static BOOST_FORCEINLINE __m256i make_avx2(
+    std::uint64_t hash,std::size_t kp)
+  {
+    const __m256i ones=_mm256_and_si256(
+      _mm256_cmpgt_epi32(
+        _mm256_set1_epi32((int)kp),_mm256_set_epi32(7,6,5,4,3,2,1,0)),
+      _mm256_set1_epi32(1));
+
+    __m256i h=_mm256_set1_epi64x((long long)hash);
+    h=_mm256_sllv_epi64(h,_mm256_set_epi64x(15,10,5,0));
+    h=_mm256_srli_epi32(h,32-5);
+    return _mm256_sllv_epi32(ones,h);
+  }
+
+  BOOST_BLOOM_TARGET_AVX2 static BOOST_FORCEINLINE void mark_avx2(
+    unsigned char* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=make_avx2(hash,kp);
+    _mm256_storeu_si256(
+      (__m256i*)p,_mm256_or_si256(_mm256_loadu_si256((const __m256i*)p),h));
+  }
+
+  BOOST_BLOOM_TARGET_AVX2 static BOOST_FORCEINLINE bool check_avx2(
+    const unsigned char* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=make_avx2(hash,kp);
+    return _mm256_testc_si256(_mm256_loadu_si256((const __m256i*)p),h)!=0;
+  }
+
+  BOOST_BLOOM_TARGET_AVX2 static BOOST_FORCEINLINE bool try_mark_avx2(
+    unsigned char* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=make_avx2(hash,kp);
+    __m256i x=_mm256_loadu_si256((const __m256i*)p);
+    bool    res=_mm256_testc_si256(x,h)==0;
+    _mm256_storeu_si256((__m256i*)p,_mm256_or_si256(x,h));
+    return res;
+  }
+
+  BOOST_BLOOM_TARGET_AVX2 static void mark_avx2(
+    unsigned char* p,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      mark_avx2(p+32*i,hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8)mark_avx2(p+32*(k/8),hash,k%8);
+  }
+
+  BOOST_BLOOM_TARGET_AVX2 static bool check_avx2(
+    const unsigned char* p,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      if(!check_avx2(p+32*i,hash,8))return false;
+      hash=detail::mulx64(hash);
+    }
+    return k%8==0||check_avx2(p+32*(k/8),hash,k%8);
+  }
+
+  BOOST_BLOOM_TARGET_AVX2 static bool try_mark_avx2(
+    unsigned char* p,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<k/8;++i){
+      res|=try_mark_avx2(p+32*i,hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8)res|=try_mark_avx2(p+32*(k/8),hash,k%8);
+    return res;
+  }
+
+  BOOST_BLOOM_FAST_MULTIBLOCK_WINDOW_KERNELS(BOOST_BLOOM_TARGET_AVX2,avx2)
+
+  /* AVX-512: pairs of groups are processed at once, a trailing group of
+   * up to 8 lanes is processed with AVX2 (see
+   * fast_multiblock32_avx512.hpp).
+   */
+
+  BOOST_BLOOM_TARGET_AVX512 static BOOST_FORCEINLINE __m512i make_avx512(
+    std::uint64_t& hash,std::size_t kp)
+  {
+    std::uint64_t hash0=hash,
+                  hash1=detail::mulx64(hash0);
+    hash=detail::mulx64(hash1);
+
+    __m512i h=_mm512_inserti64x4(
+      _mm512_castsi256_si512(_mm256_set1_epi64x((long long)hash0)),
+      _mm256_set1_epi64x((long long)hash1),1);
+    h=_mm512_sllv_epi64(h,_mm512_set_epi64(15,10,5,0,15,10,5,0));
+    h=_mm512_srli_epi32(h,32-5);
+    return _mm512_maskz_sllv_epi32(
+      (__mmask16)((1u<<kp)-1),_mm512_set1_epi32(1),h);
+  }
+
+  BOOST_BLOOM_TARGET_AVX512 static BOOST_FORCEINLINE void mark_avx512(
+    unsigned char* p,std::uint64_t& hash,std::size_t kp)
+  {
+    __m512i h=make_avx512(hash,kp);
+    _mm512_storeu_si512(
+      (void*)p,_mm512_or_si512(_mm512_loadu_si512((const void*)p),h));
+  }
+
+  BOOST_BLOOM_TARGET_AVX512 static BOOST_FORCEINLINE bool check_avx512(
+    const unsigned char* p,std::uint64_t& hash,std::size_t kp)
+  {
+    __m512i h=make_avx512(hash,kp);
+    __m512i m=_mm512_andnot_si512(_mm512_loadu_si512((const void*)p),h);
+    return _mm512_test_epi32_mask(m,m)==0;
+  }
+
+  BOOST_BLOOM_TARGET_AVX512 static BOOST_FORCEINLINE bool try_mark_avx512(
+    unsigned char* p,std::uint64_t& hash,std::size_t kp)
+  {
+    __m512i h=make_avx512(hash,kp);
+    __m512i x=_mm512_loadu_si512((const void*)p);
+    __m512i m=_mm512_andnot_si512(x,h);
+    _mm512_storeu_si512((void*)p,_mm512_or_si512(x,h));
+    return _mm512_test_epi32_mask(m,m)!=0;
+  }
+
+  BOOST_BLOOM_TARGET_AVX512 static void mark_avx512(
+    unsigned char* p,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/16;++i)mark_avx512(p+64*i,hash,16);
+    if(k%16>8)mark_avx512(p+64*(k/16),hash,k%16);
+    else if(k%16)mark_avx2(p+64*(k/16),hash,k%16);
+  }
+
+  BOOST_BLOOM_TARGET_AVX512 static bool check_avx512(
+    const unsigned char* p,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/16;++i){
+      if(!check_avx512(p+64*i,hash,16))return false;
+    }
+    if(k%16>8)return check_avx512(p+64*(k/16),hash,k%16);
+    else return k%16==0||check_avx2(p+64*(k/16),hash,k%16);
+  }
+
+  BOOST_BLOOM_TARGET_AVX512 static bool try_mark_avx512(
+    unsigned char* p,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<k/16;++i)res|=try_mark_avx512(p+64*i,hash,16);
+    if(k%16>8)res|=try_mark_avx512(p+64*(k/16),hash,k%16);
+    else if(k%16)res|=try_mark_avx2(p+64*(k/16),hash,k%16);
+    return res;
+  }
+
+  BOOST_BLOOM_FAST_MULTIBLOCK_WINDOW_KERNELS(BOOST_BLOOM_TARGET_AVX512,avx512)
+#endif
+
+  static fast_multiblock_kernel_table table(simd_level level)
+  {
+    switch(level){
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+      case simd_level::avx512:
+        return {
+          &mark_avx512,&check_avx512,&try_mark_avx512,
+          &mark_blocks_avx512,&check_blocks_avx512};
+      case simd_level::avx2:
+        return {
+          &mark_avx2,&check_avx2,&try_mark_avx2,
+          &mark_blocks_avx2,&check_blocks_avx2};
+      case simd_level::sse2:
+        return {
+          &mark_sse2,&check_sse2,&try_mark_sse2,
+          &mark_blocks_sse2,&check_blocks_sse2};
+#endif
+      default:
+        return {
+          &mark_portable,&check_portable,&try_mark_portable,
+          &mark_blocks_portable,&check_blocks_portable};
+    }
+  }
+
+  static const fast_multiblock_kernel_table& runtime_table()
+  {
+    static const fast_multiblock_kernel_table t=table(runtime_simd_level());
+    return t;
+  }
+};
+
+template<std::size_t K>
+struct fast_multiblock64_kernels
+{
+  static constexpr std::size_t k=K;
+  using portable=fast_multiblock_portable_kernels<8>;
+
+  static void mark_portable(unsigned char* p,std::uint64_t hash)
+  {
+    portable::template mark<k>(p,hash);
+  }
+
+  static bool check_portable(const unsigned char* p,std::uint64_t hash)
+  {
+    return portable::template check<k>(p,hash);
+  }
+
+  static bool try_mark_portable(unsigned char* p,std::uint64_t hash)
+  {
+    return portable::template try_mark<k>(p,hash);
+  }
+
+  BOOST_BLOOM_FAST_MULTIBLOCK_WINDOW_KERNELS(,portable)
+
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+  /* AVX2 */
+
+  BOOST_BLOOM_TARGET_AVX2 static BOOST_FORCEINLINE void make_avx2(
+    std::uint64_t hash,std::size_t kp,__m256i& lo,__m256i& hi)
+  {
+    const __m256i one=_mm256_set1_epi64x(1),
+                  n=_mm256_set1_epi64x((long long)kp);
+
+    __m256i h=_mm256_set1_epi64x((long long)hash);
+    h=_mm256_sllv_epi64(h,_mm256_set_epi64x(18,12,6,0));
+    h=_mm256_srli_epi32(h,32-6);
+    lo=_mm256_sllv_epi64(
+      _mm256_and_si256(
+        _mm256_cmpgt_epi64(n,_mm256_set_epi64x(3,2,1,0)),one),
+      _mm256_cvtepu32_epi64(_mm256_extracti128_si256(h,0)));
+    hi=_mm256_sllv_epi64(
+      _mm256_and_si256(
+        _mm256_cmpgt_epi64(n,_mm256_set_epi64x(7,6,5,4)),one),
+      _mm256_cvtepu32_epi64(_mm256_extracti128_si256(h,1)));
+  }
+
+  BOOST_BLOOM_TARGET_AVX2 static BOOST_FORCEINLINE void mark_avx2(
+    unsigned char* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m256i lo,hi;
+    make_avx2(hash,kp,lo,hi);
+    _mm256_storeu_si256(
+      (__m256i*)p,_mm256_or_si256(_mm256_loadu_si256((const __m256i*)p),lo));
+    if(kp>4){
+      _mm256_storeu_si256(
+        (__m256i*)(p+32),
+        _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(p+32)),hi));
+    }
+  }
+
+  BOOST_BLOOM_TARGET_AVX2 static BOOST_FORCEINLINE bool check_avx2(
+    const unsigned char* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m256i lo,hi;
+    make_avx2(hash,kp,lo,hi);
+    return
+      _mm256_testc_si256(_mm256_loadu_si256((const __m256i*)p),lo)&&
+      (kp<=4||
+       _mm256_testc_si256(_mm256_loadu_si256((const __m256i*)(p+32)),hi));
+  }
+
+  BOOST_BLOOM_TARGET_AVX2 static BOOST_FORCEINLINE bool try_mark_avx2(
+    unsigned char* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m256i lo,hi;
+    make_avx2(hash,kp,lo,hi);
+    __m256i x=_mm256_loadu_si256((const __m256i*)p);
+    bool    res=_mm256_testc_si256(x,lo)==0;
+    _mm256_storeu_si256((__m256i*)p,_mm256_or_si256(x,lo));
+    if(kp>4){
+      x=_mm256_loadu_si256((const __m256i*)(p+32));
+      res|=_mm256_testc_si256(x,hi)==0;
+      _mm256_storeu_si256((__m256i*)(p+32),_mm256_or_si256(x,hi));
+    }
+    return res;
+  }
+
+  BOOST_BLOOM_TARGET_AVX2 static void mark_avx2(
+    unsigned char* p,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      mark_avx2(p+64*i,hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8)mark_avx2(p+64*(k/8),hash,k%8);
+  }
+
+  BOOST_BLOOM_TARGET_AVX2 static bool check_avx2(
+    const unsigned char* p,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      if(!check_avx2(p+64*i,hash,8))return false;
+      hash=detail::mulx64(hash);
+    }
+    return k%8==0||check_avx2(p+64*(k/8),hash,k%8);
+  }
+
+  BOOST_BLOOM_TARGET_AVX2 static bool try_mark_avx2(
+    unsigned char* p,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<k/8;++i){
+      res|=try_mark_avx2(p+64*i,hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8)res|=try_mark_avx2(p+64*(k/8),hash,k%8);
+    return res;
+  }
+
+  BOOST_BLOOM_FAST_MULTIBLOCK_WINDOW_KERNELS(BOOST_BLOOM_TARGET_AVX2,avx2)
+
+  /* AVX-512 */
+
+  BOOST_BLOOM_TARGET_AVX512 static BOOST_FORCEINLINE __m512i make_avx512(
+    std::uint64_t hash,std::size_t kp)
+  {
+    __m256i h=_mm256_set1_epi64x((long long)hash);
+    h=_mm256_sllv_epi64(h,_mm256_set_epi64x(18,12,6,0));
+    h=_mm256_srli_epi32(h,32-6);
+    return _mm512_maskz_sllv_epi64(
+      (__mmask8)((1u<<kp)-1),_mm512_set1_epi64(1),_mm512_cvtepu32_epi64(h));
+  }
+
+  BOOST_BLOOM_TARGET_AVX512 static BOOST_FORCEINLINE void mark_avx512(
+    unsigned char* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m512i h=make_avx512(hash,kp);
+    _mm512_storeu_si512(
+      (void*)p,_mm512_or_si512(_mm512_loadu_si512((const void*)p),h));
+  }
+
+  BOOST_BLOOM_TARGET_AVX512 static BOOST_FORCEINLINE bool check_avx512(
+    const unsigned char* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m512i h=make_avx512(hash,kp);
+    __m512i m=_mm512_andnot_si512(_mm512_loadu_si512((const void*)p),h);
+    return _mm512_test_epi64_mask(m,m)==0;
+  }
+
+  BOOST_BLOOM_TARGET_AVX512 static BOOST_FORCEINLINE bool try_mark_avx512(
+    unsigned char* p,std::uint64_t hash,std::size_t kp)
+  {
+    __m512i h=make_avx512(hash,kp);
+    __m512i x=_mm512_loadu_si512((const void*)p);
+    __m512i m=_mm512_andnot_si512(x,h);
+    _mm512_storeu_si512((void*)p,_mm512_or_si512(x,h));
+    return _mm512_test_epi64_mask(m,m)!=0;
+  }
+
+  BOOST_BLOOM_TARGET_AVX512 static void mark_avx512(
+    unsigned char* p,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      mark_avx512(p+64*i,hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8)mark_avx512(p+64*(k/8),hash,k%8);
+  }
+
+  BOOST_BLOOM_TARGET_AVX512 static bool check_avx512(
+    const unsigned char* p,std::uint64_t hash)
+  {
+    for(std::size_t i=0;i<k/8;++i){
+      if(!check_avx512(p+64*i,hash,8))return false;
+      hash=detail::mulx64(hash);
+    }
+    return k%8==0||check_avx512(p+64*(k/8),hash,k%8);
+  }
+
+  BOOST_BLOOM_TARGET_AVX512 static bool try_mark_avx512(
+    unsigned char* p,std::uint64_t hash)
+  {
+    bool res=false;
+    for(std::size_t i=0;i<k/8;++i){
+      res|=try_mark_avx512(p+64*i,hash,8);
+      hash=detail::mulx64(hash);
+    }
+    if(k%8)res|=try_mark_avx512(p+64*(k/8),hash,k%8);
+    return res;
+  }
+
+  BOOST_BLOOM_FAST_MULTIBLOCK_WINDOW_KERNELS(BOOST_BLOOM_TARGET_AVX512,avx512)
+#endif
+
+  /* no SSE2 kernel: emulation with 128-bit registers is slower than
+   * portable code (see fast_multiblock64.hpp)
+   */
+
+  static fast_multiblock_kernel_table table(simd_level level)
+  {
+    switch(level){
+#if defined(BOOST_BLOOM_RUNTIME_DISPATCH)
+      case simd_level::avx512:
+        return {
+          &mark_avx512,&check_avx512,&try_mark_avx512,
+          &mark_blocks_avx512,&check_blocks_avx512};
+      case simd_level::avx2:
+        return {
+          &mark_avx2,&check_avx2,&try_mark_avx2,
+          &mark_blocks_avx2,&check_blocks_avx2};
+#endif
+      default:
+        return {
+          &mark_portable,&check_portable,&try_mark_portable,
+          &mark_blocks_portable,&check_blocks_portable};
+    }
+  }
+
+  static const fast_multiblock_kernel_table& runtime_table()
+  {
+    static const fast_multiblock_kernel_table t=table(runtime_simd_level());
+    return t;
+  }
+};
+
+#undef BOOST_BLOOM_FAST_MULTIBLOCK_WINDOW_KERNELS
+
+#if defined(BOOST_GCC)&&BOOST_GCC>=120000&&BOOST_GCC<130000
+#pragma GCC diagnostic pop /* -W[maybe-]uninitialized */
+#endif
+
+#if defined(BOOST_MSVC)
+#pragma warning(pop) /* C4714 */
+#endif
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,219 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_NUMA_HPP
+#define BOOST_BLOOM_DETAIL_NUMA_HPP
+
+#include <boost/bloom/detail/parallel.hpp>
+#include <boost/config.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#define BOOST_BLOOM_HAS_NUMA
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* NUMA topology as described by sysfs (/sys/devices/system/node), which is
+ * what libnuma itself reads, so no library needs to be linked. Only nodes
+ * with CPUs are reported, as memory-only nodes can't host the threads
+ * accessing the memory. In the absence of NUMA information (non-Linux
+ * platforms, sysfs not mounted), the topology consists of a single
+ * node with no CPUs listed.
+ */
+
+struct numa_node
+{
+  unsigned              id;
+  std::vector<unsigned> cpus;
+};
+
+/* parses lists such as "0-3,8,10-11" */
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline bool parse_cpu_list(const std::string& str,std::vector<unsigned>& res)
+{
+  static constexpr unsigned max_value=1u<<20;
+
+  res.clear();
+  std::size_t i=0,n=str.size();
+  while(n&&(str[n-1]=='\n'||str[n-1]==' '))--n;
+  auto parse_uint=[&](unsigned& x){
+    if(i==n||str[i]<'0'||str[i]>'9')return false;
+    for(x=0;i<n&&str[i]>='0'&&str[i]<='9';++i){
+      x=x*10+(unsigned)(str[i]-'0');
+      if(x>max_value)return false;
+    }
+    return true;
+  };
+  while(i<n){
+    unsigned first,last;
+    if(!parse_uint(first))return false;
+    last=first;
+    if(i<n&&str[i]=='-'){
+      ++i;
+      if(!parse_uint(last)||last<first)return false;
+    }
+    for(unsigned x=first;x<=last;++x)res.push_back(x);
+    if(i<n&&str[i++]!=',')return false;
+  }
+  return true;
+}
+
+struct numa_topology
+{
+  numa_topology()
+  {
+#if defined(BOOST_BLOOM_HAS_NUMA)
+    static const std::string path="/sys/devices/system/node/";
+
+    std::string           line;
+    std::vector<unsigned> ids;
+    std::ifstream         ifs{path+"online"};
+    if(std::getline(ifs,line)&&parse_cpu_list(line,ids)){
+      for(auto id:ids){
+        std::ifstream ifs2{path+"node"+std::to_string(id)+"/cpulist"};
+        numa_node     node{id,{}};
+        if(std::getline(ifs2,line)&&parse_cpu_list(line,node.cpus)&&
+           !node.cpus.empty()){
+          nodes.push_back(std::move(node));
+        }
+      }
+    }
+#endif
+
+    if(nodes.empty())nodes.push_back(numa_node{0,{}});
+    for(std::size_t i=0;i<nodes.size();++i){
+      for(auto cpu:nodes[i].cpus){
+        if(cpu>=node_index_of_cpu.size())node_index_of_cpu.resize(cpu+1,0);
+        node_index_of_cpu[cpu]=i;
+      }
+    }
+  }
+
+  /* Index into nodes of the node of the CPU the calling thread runs on.
+   * sched_getcpu is a system call on some platforms, so the result is
+   * cached per thread and refreshed every refresh_period calls, which is
+   * good enough as threads seldom migrate across nodes.
+   */
+
+  std::size_t current_node_index()const noexcept
+  {
+#if defined(BOOST_BLOOM_HAS_NUMA)
+#if !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+    static constexpr unsigned refresh_period=256;
+    static thread_local std::size_t index=0;
+    static thread_local unsigned    countdown=0;
+
+    if(countdown--==0){
+      countdown=refresh_period-1;
+      index=node_index_of_current_cpu();
+    }
+    return index;
+#else
+    return node_index_of_current_cpu();
+#endif
+#else
+    return 0;
+#endif
+  }
+
+  std::vector<numa_node>   nodes;
+  std::vector<std::size_t> node_index_of_cpu;
+
+private:
+#if defined(BOOST_BLOOM_HAS_NUMA)
+  std::size_t node_index_of_current_cpu()const noexcept
+  {
+    int cpu=sched_getcpu();
+    return cpu>=0&&(std::size_t)cpu<node_index_of_cpu.size()?
+      node_index_of_cpu[(std::size_t)cpu]:0;
+  }
+#endif
+};
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline const numa_topology& get_numa_topology()
+{
+  static const numa_topology topology;
+  return topology;
+}
+
+/* Restricts the calling thread to the given CPUs. Failure is ignored,
+ * as affinity only affects performance.
+ */
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline void pin_current_thread(const std::vector<unsigned>& cpus)noexcept
+{
+#if defined(BOOST_BLOOM_HAS_NUMA)
+  if(cpus.empty())return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for(auto cpu:cpus)if(cpu<CPU_SETSIZE)CPU_SET(cpu,&set);
+  (void)pthread_setaffinity_np(pthread_self(),sizeof(set),&set);
+#else
+  (void)cpus;
+#endif
+}
+
+/* Runs f(i) for each node i, with multiple nodes in parallel on threads
+ * pinned to the CPUs of their node, so that memory first touched by f(i)
+ * gets allocated on node i under the default Linux memory policy. The
+ * first exception thrown by any f(i) is rethrown after all threads
+ * are joined.
+ */
+
+template<typename F>
+void run_on_numa_nodes(const std::vector<numa_node>& nodes,F f)
+{
+#if defined(BOOST_BLOOM_HAS_NUMA)&&defined(BOOST_BLOOM_HAS_THREADS)
+  if(nodes.size()>1){
+    exception_holder         eh;
+    std::vector<std::thread> threads;
+    threads.reserve(nodes.size());
+    BOOST_TRY{
+      for(std::size_t i=0;i<nodes.size();++i){
+        threads.emplace_back([&,i]{
+          pin_current_thread(nodes[i].cpus);
+          BOOST_TRY{
+            f(i);
+          }
+          BOOST_CATCH(...){
+            eh.capture();
+          }
+          BOOST_CATCH_END
+        });
+      }
+    }
+    BOOST_CATCH(...){
+      for(auto& th:threads)th.join();
+      BOOST_RETHROW
+    }
+    BOOST_CATCH_END
+    for(auto& th:threads)th.join();
+    eh.rethrow_if_captured();
+    return;
+  }
+#endif
+
+  for(std::size_t i=0;i<nodes.size();++i)f(i);
+}
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,132 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DETAIL_PARALLEL_HPP
+#define BOOST_BLOOM_DETAIL_PARALLEL_HPP
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_THREAD)&&\
+    !defined(BOOST_NO_CXX11_HDR_MUTEX)&&\
+    !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE)&&\
+    !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+#define BOOST_BLOOM_HAS_THREADS
+#endif
+
+#if defined(BOOST_BLOOM_HAS_THREADS)
+#include <boost/core/no_exceptions_support.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* Reusable thread barrier. If the barrier is broken (because some
+ * participant could not be launched), all waiting and future arrivals
+ * return false.
+ */
+
+class barrier
+{
+public:
+  explicit barrier(std::size_t n):count{n},expected{n}{}
+
+  bool arrive_and_wait()
+  {
+    std::unique_lock<std::mutex> lck{mut};
+    if(broken)return false;
+    auto gen=generation;
+    if(--count==0){
+      ++generation;
+      count=expected;
+      cv.notify_all();
+      return true;
+    }
+    cv.wait(lck,[&,this]{return gen!=generation||broken;});
+    return gen!=generation;
+  }
+
+  void break_barrier()
+  {
+    std::lock_guard<std::mutex> lck{mut};
+    broken=true;
+    cv.notify_all();
+  }
+
+private:
+  std::mutex              mut;
+  std::condition_variable cv;
+  std::size_t             count,expected,generation=0;
+  bool                    broken=false;
+};
+
+/* Runs f(i,bar) for i in [0,num_threads) with i=0 executed by the calling
+ * thread and the rest by newly launched threads, bar being a barrier for
+ * all of them. Exceptions thrown by f are to be caught by f itself; thread
+ * launching exceptions are propagated after breaking the barrier and
+ * joining the threads already launched.
+ */
+
+template<typename F>
+void run_parallel(std::size_t num_threads,F f)
+{
+  barrier                  bar{num_threads};
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads-1);
+  BOOST_TRY{
+    for(std::size_t i=1;i<num_threads;++i){
+      threads.emplace_back([&,i]{f(i,bar);});
+    }
+  }
+  BOOST_CATCH(...){
+    bar.break_barrier();
+    for(auto& th:threads)th.join();
+    BOOST_RETHROW
+  }
+  BOOST_CATCH_END
+  f(0,bar);
+  for(auto& th:threads)th.join();
+}
+
+/* Records the first exception thrown among a set of threads. */
+
+class exception_holder
+{
+public:
+  void capture()noexcept
+  {
+    std::lock_guard<std::mutex> lck{mut};
+    if(!ep)ep=std::current_exception();
+    flag.store(true);
+  }
+
+  bool captured()const noexcept{return flag.load();}
+
+  void rethrow_if_captured()
+  {
+    if(ep)std::rethrow_exception(ep);
+  }
+
+private:
+  std::mutex         mut;
+  std::exception_ptr ep;
+  std::atomic<bool>  flag{false};
+};
+
+} /* namespace detail */
+} /* namespace bloom */
+} /* namespace boost */
+#endif
+
+#endif
@@ -0,0 +1,61 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DISPATCHED_FAST_MULTIBLOCK32_HPP
+#define BOOST_BLOOM_DISPATCHED_FAST_MULTIBLOCK32_HPP
+
+#include <boost/bloom/detail/fast_multiblock_kernels.hpp>
+#include <boost/bloom/detail/multiblock_fpr_base.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost{
+namespace bloom{
+
+/* Same bit mapping as the AVX2 implementation of fast_multiblock32, with
+ * kernels selected at run time for the instruction set available (see
+ * detail/fast_multiblock_kernels.hpp).
+ */
+
+template<std::size_t K>
+struct dispatched_fast_multiblock32:detail::multiblock_fpr_base<K>
+{
+  static constexpr std::size_t k=K;
+  using value_type=std::uint32_t[8*((k+7)/8)];
+  static constexpr std::size_t used_value_size=sizeof(std::uint32_t)*k;
+
+  static BOOST_FORCEINLINE void mark(value_type& x,std::uint64_t hash)
+  {
+    kernels::runtime_table().mark((unsigned char*)x,hash);
+  }
+
+  static BOOST_FORCEINLINE bool check(const value_type& x,std::uint64_t hash)
+  {
+    return kernels::runtime_table().check((const unsigned char*)x,hash);
+  }
+
+  static BOOST_FORCEINLINE bool try_mark(value_type& x,std::uint64_t hash)
+  {
+    return kernels::runtime_table().try_mark((unsigned char*)x,hash);
+  }
+
+  /* window kernels for filter's bulk operations, see detail/core.hpp */
+
+  static const detail::fast_multiblock_kernel_table& bulk_kernels()
+  {
+    return kernels::runtime_table();
+  }
+
+private:
+  using kernels=detail::fast_multiblock32_kernels<K>;
+};
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,292 @@
+/* Bloom filter with the number of subfilter operations specified at run
+ * time.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_DYNAMIC_FILTER_HPP
+#define BOOST_BLOOM_DYNAMIC_FILTER_HPP
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+/* dynamic_filter is filter with k passed at construction time rather than
+ * as a template parameter. For equal k, both produce exactly the same
+ * array contents. The implementation relies on filter<T,0,...>, whose
+ * filter_core stores k as a data member (see detail::k_storage) and
+ * dispatches the most common values of k to the same code as the static
+ * case.
+ */
+
+template<
+  typename T,
+  typename Subfilter=block<unsigned char,1>,std::size_t Stride=0,
+  typename Hash=boost::hash<T>,typename Allocator=std::allocator<unsigned char>
+>
+class dynamic_filter:private filter<T,0,Subfilter,Stride,Hash,Allocator>
+{
+  using super=filter<T,0,Subfilter,Stride,Hash,Allocator>;
+  using core=detail::filter_core<0,Subfilter,Stride,Allocator>;
+  using k_base=typename core::k_base;
+
+public:
+  using value_type=typename super::value_type;
+  using subfilter=typename super::subfilter;
+  using super::stride;
+  using super::bulk_insert_size;
+  using super::bulk_may_contain_size;
+  using hasher=typename super::hasher;
+  using allocator_type=typename super::allocator_type;
+  using size_type=typename super::size_type;
+  using difference_type=typename super::difference_type;
+  using reference=typename super::reference;
+  using const_reference=typename super::const_reference;
+  using pointer=typename super::pointer;
+  using const_pointer=typename super::const_pointer;
+
+  dynamic_filter():super{k_base{},0,hasher(),allocator_type()}{}
+
+  dynamic_filter(
+    std::size_t k,std::size_t m,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    super{k_base{k},m,h,al}{}
+
+  dynamic_filter(
+    std::size_t k,std::size_t n,double fpr,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    super{k_base{k},n,fpr,h,al}{}
+
+  template<typename InputIterator>
+  dynamic_filter(
+    InputIterator first,InputIterator last,
+    std::size_t k,std::size_t m,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    dynamic_filter{k,m,h,al}
+  {
+    insert(first,last);
+  }
+
+  template<typename InputIterator>
+  dynamic_filter(
+    InputIterator first,InputIterator last,
+    std::size_t k,std::size_t n,double fpr,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    dynamic_filter{k,n,fpr,h,al}
+  {
+    insert(first,last);
+  }
+
+  dynamic_filter(const dynamic_filter&)=default;
+  dynamic_filter(dynamic_filter&&)=default;
+
+  template<typename InputIterator>
+  dynamic_filter(
+    InputIterator first,InputIterator last,
+    std::size_t k,std::size_t m,const allocator_type& al):
+    dynamic_filter{first,last,k,m,hasher(),al}{}
+
+  template<typename InputIterator>
+  dynamic_filter(
+    InputIterator first,InputIterator last,
+    std::size_t k,std::size_t n,double fpr,const allocator_type& al):
+    dynamic_filter{first,last,k,n,fpr,hasher(),al}{}
+
+  explicit dynamic_filter(const allocator_type& al):
+    super{k_base{},0,hasher(),al}{}
+
+  dynamic_filter(const dynamic_filter& x,const allocator_type& al):
+    super{x,al}{}
+
+  dynamic_filter(dynamic_filter&& x,const allocator_type& al):
+    super{std::move(x),al}{}
+
+  dynamic_filter(
+    std::initializer_list<value_type> il,
+    std::size_t k,std::size_t m,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    dynamic_filter{il.begin(),il.end(),k,m,h,al}{}
+
+  dynamic_filter(
+    std::initializer_list<value_type> il,
+    std::size_t k,std::size_t n,double fpr,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    dynamic_filter{il.begin(),il.end(),k,n,fpr,h,al}{}
+
+  dynamic_filter(std::size_t k,std::size_t m,const allocator_type& al):
+    dynamic_filter{k,m,hasher(),al}{}
+
+  dynamic_filter(
+    std::size_t k,std::size_t n,double fpr,const allocator_type& al):
+    dynamic_filter{k,n,fpr,hasher(),al}{}
+
+  dynamic_filter(
+    std::initializer_list<value_type> il,
+    std::size_t k,std::size_t m,const allocator_type& al):
+    dynamic_filter{il.begin(),il.end(),k,m,hasher(),al}{}
+
+  dynamic_filter(
+    std::initializer_list<value_type> il,
+    std::size_t k,std::size_t n,double fpr,const allocator_type& al):
+    dynamic_filter{il.begin(),il.end(),k,n,fpr,hasher(),al}{}
+
+  dynamic_filter& operator=(const dynamic_filter&)=default;
+
+  dynamic_filter& operator=(dynamic_filter&& x)
+    noexcept(noexcept(std::declval<super&>()=(std::declval<super&&>())))
+  {
+    super::operator=(std::move(x));
+    return *this;
+  }
+
+  dynamic_filter& operator=(std::initializer_list<value_type> il)
+  {
+    super::operator=(il);
+    return *this;
+  }
+
+  using super::get_allocator;
+
+  std::size_t k()const noexcept
+  {
+    return static_cast<const core&>(static_cast<const super&>(*this)).get_k();
+  }
+
+  using super::capacity;
+
+  static std::size_t capacity_for(std::size_t k,std::size_t n,double fpr)
+  {
+    return core::capacity_for(k_base{k},n,fpr);
+  }
+
+  static double fpr_for(std::size_t k,std::size_t n,std::size_t m)
+  {
+    return core::fpr_for(k_base{k},n,m);
+  }
+
+  using super::array;
+  using super::estimated_size;
+  using super::estimated_fpr;
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  using super::parallel_estimated_size;
+  using super::parallel_estimated_fpr;
+#endif
+
+  using super::insert;
+  using super::try_insert;
+  using super::insert_hash;
+  using super::try_insert_hash;
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  using super::parallel_insert;
+  using super::parallel_insert_hash;
+#endif
+
+  void swap(dynamic_filter& x)
+    noexcept(noexcept(std::declval<super&>().swap(std::declval<super&>())))
+  {
+    super::swap(x);
+  }
+
+  using super::clear;
+  using super::reset;
+
+  dynamic_filter& operator&=(const dynamic_filter& x)
+  {
+    super::operator&=(x);
+    return *this;
+  }
+
+  dynamic_filter& operator|=(const dynamic_filter& x)
+  {
+    super::operator|=(x);
+    return *this;
+  }
+
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  dynamic_filter& parallel_and(
+    const dynamic_filter& x,std::size_t num_threads=0)
+  {
+    super::parallel_and(x,num_threads);
+    return *this;
+  }
+
+  dynamic_filter& parallel_or(
+    const dynamic_filter& x,std::size_t num_threads=0)
+  {
+    super::parallel_or(x,num_threads);
+    return *this;
+  }
+#endif
+
+  std::size_t estimated_union_size(const dynamic_filter& x)const
+  {
+    return super::estimated_union_size(x);
+  }
+
+  std::size_t estimated_intersection_size(const dynamic_filter& x)const
+  {
+    return super::estimated_intersection_size(x);
+  }
+
+  double estimated_jaccard_similarity(const dynamic_filter& x)const
+  {
+    return super::estimated_jaccard_similarity(x);
+  }
+
+  using super::hash_function;
+  using super::hash_for;
+
+  using super::may_contain;
+  using super::may_contain_bitmap;
+  using super::may_contain_selection;
+  using super::may_contain_hash;
+  using super::may_contain_hash_bitmap;
+  using super::may_contain_hash_selection;
+
+private:
+  template<
+    typename T1,typename SF,std::size_t S,typename H,typename A
+  >
+  bool friend operator==(
+    const dynamic_filter<T1,SF,S,H,A>& x,
+    const dynamic_filter<T1,SF,S,H,A>& y);
+};
+
+template<typename T,typename SF,std::size_t S,typename H,typename A>
+bool operator==(
+  const dynamic_filter<T,SF,S,H,A>& x,const dynamic_filter<T,SF,S,H,A>& y)
+{
+  using super=typename dynamic_filter<T,SF,S,H,A>::super;
+  return static_cast<const super&>(x)==static_cast<const super&>(y);
+}
+
+template<typename T,typename SF,std::size_t S,typename H,typename A>
+bool operator!=(
+  const dynamic_filter<T,SF,S,H,A>& x,const dynamic_filter<T,SF,S,H,A>& y)
+{
+  return !(x==y);
+}
+
+template<typename T,typename SF,std::size_t S,typename H,typename A>
+void swap(dynamic_filter<T,SF,S,H,A>& x,dynamic_filter<T,SF,S,H,A>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -10,10 +10,13 @@
 #define BOOST_BLOOM_FAST_MULTIBLOCK32_HPP
 
 #include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/avx512.hpp>
 #include <boost/bloom/detail/neon.hpp>
 #include <boost/bloom/detail/sse2.hpp>
 
-#if defined(BOOST_BLOOM_AVX2)
+#if defined(BOOST_BLOOM_AVX512)
+#include <boost/bloom/detail/fast_multiblock32_avx512.hpp>
+#elif defined(BOOST_BLOOM_AVX2) /* important that this comes after AVX512 */
 #include <boost/bloom/detail/fast_multiblock32_avx2.hpp>
 #elif defined(BOOST_BLOOM_SSE2) /* important that this comes after AVX2 */
 #include <boost/bloom/detail/fast_multiblock32_sse2.hpp>
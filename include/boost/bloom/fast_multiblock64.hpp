@@ -10,22 +10,17 @@
 #define BOOST_BLOOM_FAST_MULTIBLOCK64_HPP
 
 #include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/detail/avx512.hpp>
+#include <boost/bloom/detail/neon.hpp>
 
-#if defined(BOOST_BLOOM_AVX2)
+#if defined(BOOST_BLOOM_AVX512)
+#include <boost/bloom/detail/fast_multiblock64_avx512.hpp>
+#elif defined(BOOST_BLOOM_AVX2) /* important that this comes after AVX512 */
 #include <boost/bloom/detail/fast_multiblock64_avx2.hpp>
+#elif defined(BOOST_BLOOM_LITTLE_ENDIAN_NEON)
+#include <boost/bloom/detail/fast_multiblock64_neon.hpp>
 #else /* fallback */
-#include <boost/bloom/multiblock.hpp>
-#include <cstddef>
-#include <cstdint>
-
-namespace boost{
-namespace bloom{
-
-template<std::size_t K>
-using fast_multiblock64=multiblock<std::uint64_t,K>;
-
-} /* namespace bloom */
-} /* namespace boost */
+#include <boost/bloom/detail/fast_multiblock64_portable.hpp>
 #endif
 
 #endif
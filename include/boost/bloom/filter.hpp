@@ -21,8 +21,10 @@
 #include <boost/container_hash/hash_is_avalanching.hpp>
 #include <boost/core/allocator_traits.hpp>
 #include <boost/core/empty_value.hpp>
+#include <boost/core/span.hpp>
 #include <cstdint>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -68,6 +70,18 @@ struct mulx64_mix_policy
 #pragma warning(disable:4714) /* marked as __forceinline not inlined */
 #endif
 
+template<
+  typename T,typename Subfilter,std::size_t Stride,
+  typename Hash,typename Allocator
+>
+class dynamic_filter;
+
+template<
+  typename T,std::size_t K,typename Subfilter,std::size_t Stride,
+  typename Hash
+>
+class filter_view;
+
 template<
   typename T,std::size_t K,
   typename Subfilter=block<unsigned char,1>,std::size_t Stride=0,
@@ -102,6 +116,8 @@ public:
   using super::k;
   using subfilter=typename super::subfilter;
   using super::stride;
+  using super::bulk_insert_size;
+  using super::bulk_may_contain_size;
   using hasher=Hash;
   using allocator_type=Allocator;
   using size_type=typename super::size_type;
@@ -111,17 +127,17 @@ public:
   using pointer=value_type*;
   using const_pointer=const value_type*;
 
-  filter()=default;
+  filter():super{static_k(),0,allocator_type()}{}
 
   explicit filter(
     std::size_t m,const hasher& h=hasher(),
     const allocator_type& al=allocator_type()):
-    super{m,al},hash_base{empty_init,h}{}
+    super{static_k(),m,al},hash_base{empty_init,h}{}
 
   filter(
     std::size_t n,double fpr,const hasher& h=hasher(),
     const allocator_type& al=allocator_type()):
-    super{n,fpr,al},hash_base{empty_init,h}{}
+    super{static_k(),n,fpr,al},hash_base{empty_init,h}{}
 
   template<typename InputIterator>
   filter(
@@ -228,6 +244,20 @@ public:
   using super::capacity_for;
   using super::fpr_for;
   using super::array;
+  using super::estimated_size;
+  using super::estimated_fpr;
+
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  std::size_t parallel_estimated_size(std::size_t num_threads=0)const
+  {
+    return super::parallel_estimated_size(default_num_threads(num_threads));
+  }
+
+  double parallel_estimated_fpr(std::size_t num_threads=0)const
+  {
+    return super::parallel_estimated_fpr(default_num_threads(num_threads));
+  }
+#endif
 
   BOOST_FORCEINLINE void insert(const T& x)
   {
@@ -243,10 +273,26 @@ public:
     super::insert(hash_for(x));
   }
 
+  BOOST_FORCEINLINE bool try_insert(const T& x)
+  {
+    return super::try_insert(hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool try_insert(const U& x)
+  {
+    return super::try_insert(hash_for(x));
+  }
+
   template<typename InputIterator>
   void insert(InputIterator first,InputIterator last)
   {
-    while(first!=last)insert(*first++);
+    insert_range(
+      first,last,hash_function_ref{this},
+      typename std::iterator_traits<InputIterator>::iterator_category{});
   }
 
   void insert(std::initializer_list<value_type> il)
@@ -254,6 +300,38 @@ public:
     insert(il.begin(),il.end());
   }
 
+  BOOST_FORCEINLINE void insert_hash(std::uint64_t hash)
+  {
+    super::insert(hash);
+  }
+
+  BOOST_FORCEINLINE bool try_insert_hash(std::uint64_t hash)
+  {
+    return super::try_insert(hash);
+  }
+
+  template<typename InputIterator>
+  void insert_hash(InputIterator first,InputIterator last)
+  {
+    insert_range(
+      first,last,identity_hash{},
+      typename std::iterator_traits<InputIterator>::iterator_category{});
+  }
+
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  void parallel_insert(
+    boost::span<const value_type> x,std::size_t num_threads=0)
+  {
+    parallel_insert_impl(x,hash_function_ref{this},num_threads);
+  }
+
+  void parallel_insert_hash(
+    boost::span<const std::uint64_t> hashes,std::size_t num_threads=0)
+  {
+    parallel_insert_impl(hashes,identity_hash{},num_threads);
+  }
+#endif
+
   void swap(filter& x)
     noexcept(noexcept(std::declval<super&>().swap(std::declval<super&>())))
   {
@@ -279,11 +357,56 @@ public:
     return *this;
   }
 
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  filter& parallel_and(const filter& x,std::size_t num_threads=0)
+  {
+    super::parallel_and(x,default_num_threads(num_threads));
+    return *this;
+  }
+
+  filter& parallel_or(const filter& x,std::size_t num_threads=0)
+  {
+    super::parallel_or(x,default_num_threads(num_threads));
+    return *this;
+  }
+#endif
+
+  std::size_t estimated_union_size(const filter& x)const
+  {
+    return super::estimated_union_size(x);
+  }
+
+  std::size_t estimated_intersection_size(const filter& x)const
+  {
+    return super::estimated_intersection_size(x);
+  }
+
+  double estimated_jaccard_similarity(const filter& x)const
+  {
+    return super::estimated_jaccard_similarity(x);
+  }
+
   hasher hash_function()const
   {
     return h();
   }
 
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const T& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const U& x)const
+  {
+    return mix_policy::mix(h(),x);
+  }
+
   BOOST_FORCEINLINE bool may_contain(const T& x)const
   {
     return super::may_contain(hash_for(x));
@@ -298,6 +421,53 @@ public:
     return super::may_contain(hash_for(x));
   }
 
+  template<typename InputIterator,typename F>
+  void may_contain(InputIterator first,InputIterator last,F f)const
+  {
+    may_contain_range(
+      first,last,hash_function_ref{this},f,
+      typename std::iterator_traits<InputIterator>::iterator_category{});
+  }
+
+  std::size_t may_contain_bitmap(
+    boost::span<const value_type> x,std::uint64_t* bitmap)const
+  {
+    return may_contain_bitmap_impl(x,hash_function_ref{this},bitmap);
+  }
+
+  template<typename Index>
+  std::size_t may_contain_selection(
+    boost::span<const value_type> x,Index* selection)const
+  {
+    return may_contain_selection_impl(x,hash_function_ref{this},selection);
+  }
+
+  BOOST_FORCEINLINE bool may_contain_hash(std::uint64_t hash)const
+  {
+    return super::may_contain(hash);
+  }
+
+  template<typename InputIterator,typename F>
+  void may_contain_hash(InputIterator first,InputIterator last,F f)const
+  {
+    may_contain_range(
+      first,last,identity_hash{},f,
+      typename std::iterator_traits<InputIterator>::iterator_category{});
+  }
+
+  std::size_t may_contain_hash_bitmap(
+    boost::span<const std::uint64_t> hashes,std::uint64_t* bitmap)const
+  {
+    return may_contain_bitmap_impl(hashes,identity_hash{},bitmap);
+  }
+
+  template<typename Index>
+  std::size_t may_contain_hash_selection(
+    boost::span<const std::uint64_t> hashes,Index* selection)const
+  {
+    return may_contain_selection_impl(hashes,identity_hash{},selection);
+  }
+
 private:
   template<
     typename T1,std::size_t K1,typename SF,std::size_t S,typename H,typename A
@@ -305,16 +475,139 @@ private:
   bool friend operator==(
     const filter<T1,K1,SF,S,H,A>& x,const filter<T1,K1,SF,S,H,A>& y);
 
+  /* filter<T,0,...> with the number of subfilter operations specified at
+   * run time is the implementation of dynamic_filter, and can only be
+   * constructed through the private constructors taking a k_base below.
+   * Public construction goes through static_k, which rejects K==0.
+   */
+
+  template<typename,typename,std::size_t,typename,typename>
+  friend class dynamic_filter;
+
+  /* filter_view is a filter whose core doesn't own its array */
+
+  template<typename,std::size_t,typename,std::size_t,typename>
+  friend class filter_view;
+
+  using k_base=typename super::k_base;
   using hash_base=empty_value<Hash,0>;
 
+  static k_base static_k()noexcept
+  {
+    static_assert(K>0,"K must be >= 1");
+    return k_base{};
+  }
+
+  filter(
+    const k_base& kb,std::size_t m,const hasher& h,const allocator_type& al):
+    super{kb,m,al},hash_base{empty_init,h}{}
+
+  filter(
+    const k_base& kb,std::size_t n,double fpr,const hasher& h,
+    const allocator_type& al):
+    super{kb,n,fpr,al},hash_base{empty_init,h}{}
+
+  filter(
+    const k_base& kb,boost::span<const unsigned char> x,const hasher& h):
+    super{kb,x,allocator_type{}},hash_base{empty_init,h}{}
+
   const Hash& h()const{return hash_base::get();}
   Hash& h(){return hash_base::get();}
 
-  template<typename U>
-  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
-  inline std::uint64_t hash_for(const U& x)const
+  /* Range operations are shared between element and hash variants by
+   * way of a hash projection: hash_function_ref hashes its argument with
+   * the filter's hash function, identity_hash takes its argument as the
+   * hash value.
+   */
+
+  struct hash_function_ref
   {
-    return mix_policy::mix(h(),x);
+    template<typename U>
+    std::uint64_t operator()(const U& x)const{return p->hash_for(x);}
+
+    const filter* p;
+  };
+
+  struct identity_hash
+  {
+    std::uint64_t operator()(std::uint64_t hash)const{return hash;}
+  };
+
+  template<typename InputIterator,typename HashProjection>
+  void insert_range(
+    InputIterator first,InputIterator last,HashProjection hp,
+    std::input_iterator_tag)
+  {
+    while(first!=last)super::insert(hp(*first++));
+  }
+
+  template<typename ForwardIterator,typename HashProjection>
+  void insert_range(
+    ForwardIterator first,ForwardIterator last,HashProjection hp,
+    std::forward_iterator_tag)
+  {
+    auto n=static_cast<std::size_t>(std::distance(first,last));
+    super::bulk_insert([&]{return hp(*first++);},n);
+  }
+
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  template<typename U,typename HashProjection>
+  void parallel_insert_impl(
+    boost::span<const U> x,HashProjection hp,std::size_t num_threads)
+  {
+    auto first=x.data();
+    super::parallel_insert(
+      [&](std::size_t i){return hp(first[i]);},x.size(),
+      default_num_threads(num_threads));
+  }
+
+  static std::size_t default_num_threads(std::size_t num_threads)
+  {
+    return num_threads?num_threads:std::thread::hardware_concurrency();
+  }
+#endif
+
+  template<typename InputIterator,typename HashProjection,typename F>
+  void may_contain_range(
+    InputIterator first,InputIterator last,HashProjection hp,F& f,
+    std::input_iterator_tag)const
+  {
+    for(;first!=last;++first){
+      const auto& x=*first;
+      f(x,super::may_contain(hp(x)));
+    }
+  }
+
+  template<typename ForwardIterator,typename HashProjection,typename F>
+  void may_contain_range(
+    ForwardIterator first,ForwardIterator last,HashProjection hp,F& f,
+    std::forward_iterator_tag)const
+  {
+    auto n=static_cast<std::size_t>(std::distance(first,last));
+    auto it=first;
+    super::bulk_may_contain(
+      [&]{return hp(*first++);},n,
+      [&](bool res){f(*it++,res);});
+  }
+
+  template<typename U,typename HashProjection>
+  std::size_t may_contain_bitmap_impl(
+    boost::span<const U> x,HashProjection hp,std::uint64_t* bitmap)const
+  {
+    auto first=x.data();
+    return super::bulk_may_contain_bitmap(
+      [&]{return hp(*first++);},x.size(),bitmap);
+  }
+
+  template<typename U,typename HashProjection,typename Index>
+  std::size_t may_contain_selection_impl(
+    boost::span<const U> x,HashProjection hp,Index* selection)const
+  {
+    static_assert(
+      std::is_integral<Index>::value,"Index must be an integral type");
+    auto first=x.data();
+    return super::bulk_may_contain_selection(
+      [&]{return hp(*first++);},x.size(),selection);
   }
 };
 
@@ -0,0 +1,174 @@
+/* Read-only Bloom filter over an externally provided array.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_FILTER_VIEW_HPP
+#define BOOST_BLOOM_FILTER_VIEW_HPP
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/core/span.hpp>
+#include <cstddef>
+#include <utility>
+
+namespace boost{
+namespace bloom{
+
+/* filter_view provides the lookup interface of filter over an array it
+ * doesn't own, typically the body of a memory-mapped file written with
+ * save and opened with load_view. The array has the layout of
+ * filter::array(), and the sizeof(value_type)-used_value_size bytes
+ * following it must be readable, as lookups on the last block may load a
+ * whole value_type: the serialization format provides these bytes, but
+ * users dumping filter::array() directly must pad the data themselves.
+ * The implementation relies on a filter whose core
+ * points to the external array with a null filter_array::data, which
+ * makes it skip deallocation. Copy operations are redefined so that the
+ * view, rather than the array, gets copied, and no write operations are
+ * exposed.
+ */
+
+template<
+  typename T,std::size_t K,
+  typename Subfilter=block<unsigned char,1>,std::size_t Stride=0,
+  typename Hash=boost::hash<T>
+>
+class filter_view:private filter<T,K,Subfilter,Stride,Hash>
+{
+  using super=filter<T,K,Subfilter,Stride,Hash>;
+
+public:
+  using filter_type=super;
+  using value_type=typename super::value_type;
+  using super::k;
+  using subfilter=typename super::subfilter;
+  using super::stride;
+  using super::bulk_may_contain_size;
+  using hasher=typename super::hasher;
+  using size_type=typename super::size_type;
+  using difference_type=typename super::difference_type;
+  using const_reference=typename super::const_reference;
+  using const_pointer=typename super::const_pointer;
+
+  filter_view()=default;
+
+  explicit filter_view(
+    boost::span<const unsigned char> x,const hasher& h=hasher()):
+    super{super::static_k(),x,h}{}
+
+  template<typename Allocator>
+  filter_view(const filter<T,K,Subfilter,Stride,Hash,Allocator>& f):
+    filter_view{f.array(),f.hash_function()}{}
+
+  filter_view(const filter_view& x):
+    filter_view{x.array(),x.hash_function()}{}
+
+  filter_view(filter_view&&)=default;
+
+  filter_view& operator=(const filter_view& x)
+  {
+    filter_view tmp{x};
+    swap(tmp);
+    return *this;
+  }
+
+  filter_view& operator=(filter_view&& x)
+    noexcept(noexcept(std::declval<super&>()=(std::declval<super&&>())))
+  {
+    super::operator=(std::move(x));
+    return *this;
+  }
+
+  using super::capacity;
+  using super::capacity_for;
+  using super::fpr_for;
+
+  boost::span<const unsigned char> array()const noexcept
+  {
+    return super::array();
+  }
+
+  using super::estimated_size;
+  using super::estimated_fpr;
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  using super::parallel_estimated_size;
+  using super::parallel_estimated_fpr;
+#endif
+
+  void swap(filter_view& x)
+    noexcept(noexcept(std::declval<super&>().swap(std::declval<super&>())))
+  {
+    super::swap(x);
+  }
+
+  std::size_t estimated_union_size(const filter_view& x)const
+  {
+    return super::estimated_union_size(x);
+  }
+
+  std::size_t estimated_intersection_size(const filter_view& x)const
+  {
+    return super::estimated_intersection_size(x);
+  }
+
+  double estimated_jaccard_similarity(const filter_view& x)const
+  {
+    return super::estimated_jaccard_similarity(x);
+  }
+
+  using super::hash_function;
+  using super::hash_for;
+
+  using super::may_contain;
+  using super::may_contain_bitmap;
+  using super::may_contain_selection;
+  using super::may_contain_hash;
+  using super::may_contain_hash_bitmap;
+  using super::may_contain_hash_selection;
+
+private:
+  template<
+    typename T1,std::size_t K1,typename SF,std::size_t S,typename H
+  >
+  bool friend operator==(
+    const filter_view<T1,K1,SF,S,H>& x,const filter_view<T1,K1,SF,S,H>& y);
+};
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H
+>
+bool operator==(
+  const filter_view<T,K,SF,S,H>& x,const filter_view<T,K,SF,S,H>& y)
+{
+  using super=typename filter_view<T,K,SF,S,H>::super;
+  return static_cast<const super&>(x)==static_cast<const super&>(y);
+}
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H
+>
+bool operator!=(
+  const filter_view<T,K,SF,S,H>& x,const filter_view<T,K,SF,S,H>& y)
+{
+  return !(x==y);
+}
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H
+>
+void swap(filter_view<T,K,SF,S,H>& x,filter_view<T,K,SF,S,H>& y)
+  noexcept(noexcept(x.swap(y)))
+{
+  x.swap(y);
+}
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,196 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_HUGE_PAGE_ALLOCATOR_HPP
+#define BOOST_BLOOM_HUGE_PAGE_ALLOCATOR_HPP
+
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#define BOOST_BLOOM_HAS_HUGE_PAGES
+#include <sys/mman.h>
+#endif
+
+namespace boost{
+namespace bloom{
+
+#if defined(BOOST_BLOOM_HAS_HUGE_PAGES)
+namespace detail{
+
+/* Allocations of at least huge_page_size bytes are served with a private
+ * anonymous mapping backed, in order of preference, by
+ *   - 1GB pages from the hugetlbfs pool, if the allocation is at least 1GB
+ *     and rounding it up to a multiple of 1GB wastes no more than 1/16
+ *     of the size,
+ *   - 2MB pages from the hugetlbfs pool,
+ *   - regular pages aligned to 2MB and marked with MADV_HUGEPAGE, so that
+ *     the kernel backs them with transparent huge pages when enabled
+ *     (/sys/kernel/mm/transparent_hugepage/enabled set to "always" or
+ *     "madvise").
+ * The hugetlbfs pools are empty unless configured by the administrator,
+ * in which case mmap fails immediately. The mapping size is a function of
+ * the allocation size only and is a multiple of the page size of every
+ * option, so deallocation needs not know which option succeeded.
+ */
+
+static constexpr std::size_t huge_page_size=std::size_t(1)<<21;
+static constexpr std::size_t gigantic_page_size=std::size_t(1)<<30;
+
+#if defined(MAP_HUGETLB)
+static constexpr int map_huge_shift=26; /* MAP_HUGE_SHIFT */
+static constexpr int map_huge_2mb=21<<map_huge_shift;
+static constexpr int map_huge_1gb=30<<map_huge_shift;
+#endif
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline bool use_gigantic_pages(std::size_t n)noexcept
+{
+  return n>=gigantic_page_size&&
+    (gigantic_page_size-n%gigantic_page_size)%gigantic_page_size<=n/16;
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline std::size_t huge_page_mapping_size(std::size_t n)
+{
+  std::size_t ps=use_gigantic_pages(n)?gigantic_page_size:huge_page_size;
+  if(n>(std::numeric_limits<std::size_t>::max)()-2*ps){
+    BOOST_THROW_EXCEPTION(std::bad_alloc());
+  }
+  return (n+ps-1)/ps*ps;
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline void* map_huge_pages(std::size_t n)
+{
+  static constexpr int prot=PROT_READ|PROT_WRITE,
+                       flags=MAP_PRIVATE|MAP_ANONYMOUS;
+
+  auto  len=huge_page_mapping_size(n);
+  void* p=MAP_FAILED;
+#if defined(MAP_HUGETLB)
+  if(use_gigantic_pages(n)){
+    p=mmap(nullptr,len,prot,flags|MAP_HUGETLB|map_huge_1gb,-1,0);
+  }
+  if(p==MAP_FAILED){
+    p=mmap(nullptr,len,prot,flags|MAP_HUGETLB|map_huge_2mb,-1,0);
+  }
+  if(p!=MAP_FAILED)return p;
+#endif
+
+  /* Transparent huge pages require 2MB alignment: we map an extra 2MB and
+   * trim the excess at both ends.
+   */
+
+  auto q=static_cast<unsigned char*>(
+    mmap(nullptr,len+huge_page_size,prot,flags,-1,0));
+  if(q==static_cast<unsigned char*>(MAP_FAILED)){
+    BOOST_THROW_EXCEPTION(std::bad_alloc());
+  }
+  auto head=(huge_page_size-std::uintptr_t(q)%huge_page_size)%huge_page_size;
+  if(head)munmap(q,head);
+  if(huge_page_size-head)munmap(q+head+len,huge_page_size-head);
+  p=q+head;
+#if defined(MADV_HUGEPAGE)
+  madvise(p,len,MADV_HUGEPAGE); /* advisory, failure is harmless */
+#endif
+  return p;
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline void unmap_huge_pages(void* p,std::size_t n)noexcept
+{
+  munmap(p,huge_page_mapping_size(n));
+}
+
+} /* namespace detail */
+#endif
+
+/* Allocator placing large blocks of memory on huge pages where supported
+ * (Linux), and otherwise equivalent to std::allocator<T>. Intended for
+ * the Allocator parameter of filter and related classes: the arrays
+ * of multi-GB filters are accessed at random, and huge pages reduce the
+ * number of TLB misses incurred. Huge page memory starts at a page
+ * boundary, which satisfies the alignment requirements of any filter, so
+ * the filter array lies at the very beginning of the allocation.
+ */
+
+template<typename T=unsigned char>
+class huge_page_allocator
+{
+public:
+  using value_type=T;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  using propagate_on_container_move_assignment=std::true_type;
+  using is_always_equal=std::true_type;
+
+  template<typename U>
+  struct rebind{using other=huge_page_allocator<U>;};
+
+  huge_page_allocator()=default;
+
+  template<typename U>
+  huge_page_allocator(const huge_page_allocator<U>&)noexcept{}
+
+  T* allocate(std::size_t n)
+  {
+#if defined(BOOST_BLOOM_HAS_HUGE_PAGES)
+    if(n>=min_huge_size()){
+      if(n>(std::numeric_limits<std::size_t>::max)()/sizeof(T)){
+        BOOST_THROW_EXCEPTION(std::bad_alloc());
+      }
+      return static_cast<T*>(detail::map_huge_pages(n*sizeof(T)));
+    }
+#endif
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p,std::size_t n)noexcept
+  {
+#if defined(BOOST_BLOOM_HAS_HUGE_PAGES)
+    if(n>=min_huge_size()){
+      detail::unmap_huge_pages(p,n*sizeof(T));
+      return;
+    }
+#endif
+    std::allocator<T>().deallocate(p,n);
+  }
+
+private:
+#if defined(BOOST_BLOOM_HAS_HUGE_PAGES)
+  static constexpr std::size_t min_huge_size()noexcept
+  {
+    return (detail::huge_page_size+sizeof(T)-1)/sizeof(T);
+  }
+#endif
+};
+
+template<typename T,typename U>
+bool operator==(
+  const huge_page_allocator<T>&,const huge_page_allocator<U>&)noexcept
+{
+  return true;
+}
+
+template<typename T,typename U>
+bool operator!=(
+  const huge_page_allocator<T>&,const huge_page_allocator<U>&)noexcept
+{
+  return false;
+}
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -50,6 +50,18 @@ struct multiblock:
     return res;
   }
 
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  static inline bool try_mark(value_type& x,std::uint64_t hash)
+  {
+    int res=0;
+    std::size_t i=0;
+    loop(hash,[&](std::uint64_t h){
+      res|=~block_ops::get_at_lsb(x[i],h&mask);
+      block_ops::set(x[i++],h&mask);
+    });
+    return res&1;
+  }
+
 #if BOOST_WORKAROUND(BOOST_MSVC,<=1900)
 #pragma warning(pop) /* C4800 */
 #endif
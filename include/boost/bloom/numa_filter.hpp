@@ -0,0 +1,397 @@
+/* Bloom filter replicated across NUMA nodes.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_NUMA_FILTER_HPP
+#define BOOST_BLOOM_NUMA_FILTER_HPP
+
+#include <boost/assert.hpp>
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/detail/numa.hpp>
+#include <boost/bloom/detail/type_traits.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/core/span.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace boost{
+namespace bloom{
+
+/* numa_filter keeps one replica of a filter per NUMA node, with the array
+ * of each replica allocated on its node by constructing it from a thread
+ * pinned to the node's CPUs (first-touch placement). Lookups are served
+ * by the replica of the node the calling thread currently runs on, and
+ * modifying operations are applied to all replicas. The replica vector
+ * uses std::allocator: only the replicas' arrays, which are the ones
+ * benefitting from locality, use Allocator.
+ */
+
+template<
+  typename T,std::size_t K,
+  typename Subfilter=block<unsigned char,1>,std::size_t Stride=0,
+  typename Hash=boost::hash<T>,
+  typename Allocator=std::allocator<unsigned char>
+>
+class numa_filter
+{
+public:
+  using filter_type=filter<T,K,Subfilter,Stride,Hash,Allocator>;
+  using value_type=T;
+  static constexpr std::size_t k=filter_type::k;
+  using subfilter=typename filter_type::subfilter;
+  static constexpr std::size_t stride=filter_type::stride;
+  static constexpr std::size_t bulk_insert_size=filter_type::bulk_insert_size;
+  static constexpr std::size_t bulk_may_contain_size=
+    filter_type::bulk_may_contain_size;
+  using hasher=Hash;
+  using allocator_type=Allocator;
+  using size_type=std::size_t;
+  using difference_type=std::ptrdiff_t;
+  using reference=value_type&;
+  using const_reference=const value_type&;
+  using pointer=value_type*;
+  using const_pointer=const value_type*;
+
+  explicit numa_filter(
+    std::size_t m=0,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    replicas(topology().nodes.size(),filter_type{0,h,al})
+  {
+    if(m)reset(m);
+  }
+
+  numa_filter(
+    std::size_t n,double fpr,const hasher& h=hasher(),
+    const allocator_type& al=allocator_type()):
+    numa_filter{filter_type::capacity_for(n,fpr),h,al}{}
+
+  numa_filter(std::size_t m,const allocator_type& al):
+    numa_filter{m,hasher(),al}{}
+
+  numa_filter(std::size_t n,double fpr,const allocator_type& al):
+    numa_filter{n,fpr,hasher(),al}{}
+
+  explicit numa_filter(const filter_type& x):
+    replicas(
+      topology().nodes.size(),
+      filter_type{0,x.hash_function(),x.get_allocator()})
+  {
+    detail::run_on_numa_nodes(topology().nodes,[&,this](std::size_t i){
+      replicas[i]=x;
+    });
+  }
+
+  numa_filter(const numa_filter& x):numa_filter{x.replicas[0]}{}
+
+  /* x is left with empty replicas rather than none */
+
+  numa_filter(numa_filter&& x):
+    replicas(
+      x.replicas.size(),
+      filter_type{0,x.hash_function(),x.get_allocator()})
+  {
+    replicas.swap(x.replicas);
+  }
+
+  numa_filter& operator=(const numa_filter& x)
+  {
+    if(this!=&x){
+      numa_filter tmp{x};
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  numa_filter& operator=(numa_filter&& x)
+  {
+    if(this!=&x){
+      numa_filter tmp{std::move(x)};
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator()const
+  {
+    return replicas[0].get_allocator();
+  }
+
+  size_type num_replicas()const noexcept{return replicas.size();}
+
+  const filter_type& replica(size_type i)const
+  {
+    BOOST_ASSERT(i<replicas.size());
+    return replicas[i];
+  }
+
+  /* Replica on the node of the CPU the calling thread currently runs on.
+   * Threads with a fixed affinity can obtain it once and query it
+   * directly, thus saving the CPU lookup on each operation.
+   */
+
+  const filter_type& local_replica()const noexcept
+  {
+    return replicas.size()==1?
+      replicas[0]:replicas[topology().current_node_index()];
+  }
+
+  size_type capacity()const noexcept{return replicas[0].capacity();}
+
+  static size_type capacity_for(size_type n,double fpr)
+  {
+    return filter_type::capacity_for(n,fpr);
+  }
+
+  static double fpr_for(size_type n,size_type m)
+  {
+    return filter_type::fpr_for(n,m);
+  }
+
+  size_type estimated_size()const noexcept
+  {
+    return local_replica().estimated_size();
+  }
+
+  double estimated_fpr()const noexcept
+  {
+    return local_replica().estimated_fpr();
+  }
+
+  BOOST_FORCEINLINE void insert(const T& x)
+  {
+    insert_hash(replicas[0].hash_for(x));
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE void insert(const U& x)
+  {
+    insert_hash(replicas[0].hash_for(x));
+  }
+
+  /* Elements are hashed once, in chunks, and the hashes inserted into
+   * each replica with the pipelined bulk insertion of filter.
+   */
+
+  template<typename InputIterator>
+  void insert(InputIterator first,InputIterator last)
+  {
+    static constexpr std::size_t chunk_size=1024;
+
+    std::uint64_t hashes[chunk_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(;n<chunk_size&&first!=last;++first){
+        hashes[n++]=replicas[0].hash_for(*first);
+      }
+      for(auto& r:replicas)r.insert_hash(hashes,hashes+n);
+    }
+  }
+
+  void insert(std::initializer_list<value_type> il)
+  {
+    insert(il.begin(),il.end());
+  }
+
+  BOOST_FORCEINLINE void insert_hash(std::uint64_t hash)
+  {
+    for(auto& r:replicas)r.insert_hash(hash);
+  }
+
+  /* With several replicas, the input is traversed once and buffered in
+   * chunks, as in insert(first,last).
+   */
+
+  template<typename InputIterator>
+  void insert_hash(InputIterator first,InputIterator last)
+  {
+    static constexpr std::size_t chunk_size=1024;
+
+    if(replicas.size()==1){
+      replicas[0].insert_hash(first,last);
+      return;
+    }
+    std::uint64_t hashes[chunk_size];
+    while(first!=last){
+      std::size_t n=0;
+      for(;n<chunk_size&&first!=last;++first)hashes[n++]=*first;
+      for(auto& r:replicas)r.insert_hash(hashes,hashes+n);
+    }
+  }
+
+  void swap(numa_filter& x)noexcept
+  {
+    replicas.swap(x.replicas);
+  }
+
+  void clear()noexcept
+  {
+    for(auto& r:replicas)r.clear();
+  }
+
+  /* New replicas are fully allocated before replacing the current ones,
+   * so that the filter is left unchanged if allocation fails on any node.
+   */
+
+  void reset(std::size_t m=0)
+  {
+    std::vector<filter_type> tmp(
+      replicas.size(),filter_type{0,hash_function(),get_allocator()});
+    detail::run_on_numa_nodes(topology().nodes,[&](std::size_t i){
+      tmp[i].reset(m);
+    });
+    replicas.swap(tmp);
+  }
+
+  void reset(std::size_t n,double fpr)
+  {
+    reset(capacity_for(n,fpr));
+  }
+
+  /* Merges x into every replica, each from a thread on the replica's
+   * node. Intended for periodic propagation of the insertions accumulated
+   * in a staging filter.
+   */
+
+  numa_filter& operator|=(const filter_type& x)
+  {
+    detail::run_on_numa_nodes(topology().nodes,[&,this](std::size_t i){
+      replicas[i]|=x;
+    });
+    return *this;
+  }
+
+  numa_filter& operator&=(const filter_type& x)
+  {
+    detail::run_on_numa_nodes(topology().nodes,[&,this](std::size_t i){
+      replicas[i]&=x;
+    });
+    return *this;
+  }
+
+  hasher hash_function()const
+  {
+    return replicas[0].hash_function();
+  }
+
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const T& x)const
+  {
+    return replicas[0].hash_for(x);
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  /* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+  inline std::uint64_t hash_for(const U& x)const
+  {
+    return replicas[0].hash_for(x);
+  }
+
+  BOOST_FORCEINLINE bool may_contain(const T& x)const
+  {
+    return local_replica().may_contain(x);
+  }
+
+  template<
+    typename U,
+    typename H=hasher,detail::enable_if_transparent_t<H>* =nullptr
+  >
+  BOOST_FORCEINLINE bool may_contain(const U& x)const
+  {
+    return local_replica().may_contain(x);
+  }
+
+  template<typename InputIterator,typename F>
+  void may_contain(InputIterator first,InputIterator last,F f)const
+  {
+    local_replica().may_contain(first,last,f);
+  }
+
+  std::size_t may_contain_bitmap(
+    boost::span<const value_type> x,std::uint64_t* bitmap)const
+  {
+    return local_replica().may_contain_bitmap(x,bitmap);
+  }
+
+  template<typename Index>
+  std::size_t may_contain_selection(
+    boost::span<const value_type> x,Index* selection)const
+  {
+    return local_replica().may_contain_selection(x,selection);
+  }
+
+  BOOST_FORCEINLINE bool may_contain_hash(std::uint64_t hash)const
+  {
+    return local_replica().may_contain_hash(hash);
+  }
+
+  template<typename InputIterator,typename F>
+  void may_contain_hash(InputIterator first,InputIterator last,F f)const
+  {
+    local_replica().may_contain_hash(first,last,f);
+  }
+
+  std::size_t may_contain_hash_bitmap(
+    boost::span<const std::uint64_t> hashes,std::uint64_t* bitmap)const
+  {
+    return local_replica().may_contain_hash_bitmap(hashes,bitmap);
+  }
+
+  template<typename Index>
+  std::size_t may_contain_hash_selection(
+    boost::span<const std::uint64_t> hashes,Index* selection)const
+  {
+    return local_replica().may_contain_hash_selection(hashes,selection);
+  }
+
+  friend bool operator==(const numa_filter& x,const numa_filter& y)
+  {
+    return x.replicas[0]==y.replicas[0];
+  }
+
+private:
+  static const detail::numa_topology& topology()
+  {
+    return detail::get_numa_topology();
+  }
+
+  std::vector<filter_type> replicas;
+};
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
+>
+bool operator!=(
+  const numa_filter<T,K,SF,S,H,A>& x,const numa_filter<T,K,SF,S,H,A>& y)
+{
+  return !(x==y);
+}
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
+>
+void swap(numa_filter<T,K,SF,S,H,A>& x,numa_filter<T,K,SF,S,H,A>& y)
+  noexcept
+{
+  x.swap(y);
+}
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
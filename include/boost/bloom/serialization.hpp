@@ -0,0 +1,478 @@
+/* Binary serialization of Bloom filters.
+ *
+ * Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#ifndef BOOST_BLOOM_SERIALIZATION_HPP
+#define BOOST_BLOOM_SERIALIZATION_HPP
+
+#include <algorithm>
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/detail/compression.hpp>
+#include <boost/bloom/detail/core.hpp>
+#include <boost/bloom/detail/crc32c.hpp>
+#include <boost/bloom/dispatched_fast_multiblock32.hpp>
+#include <boost/bloom/dispatched_fast_multiblock64.hpp>
+#include <boost/bloom/dynamic_filter.hpp>
+#include <boost/bloom/fast_multiblock32.hpp>
+#include <boost/bloom/fast_multiblock64.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/filter_view.hpp>
+#include <boost/bloom/multiblock.hpp>
+#include <boost/config.hpp>
+#include <boost/container_hash/hash_is_avalanching.hpp>
+#include <boost/core/no_exceptions_support.hpp>
+#include <boost/core/span.hpp>
+#include <boost/throw_exception.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace boost{
+namespace bloom{
+namespace detail{
+
+/* Serialization format (version 1):
+ *
+ *   - 64-byte header:
+ *       offset size
+ *        0      8   magic "BOOSTBLM"
+ *        8      4   format version
+ *       12      4   endianness mark 0x01020304
+ *       16      8   capacity in bits
+ *       24      4   k
+ *       28      4   subfilter layout id (see subfilter_id)
+ *       32      4   subfilter::k
+ *       36      4   sizeof(subfilter::value_type)
+ *       40      4   used_value_size<subfilter>
+ *       44      4   stride
+ *       48      8   user-provided hash function id
+ *       56      4   flags (bit 0: hash values are mixed, see filter;
+ *                   bits 8-15: encoding of the body)
+ *       60      4   CRC-32C of bytes [0,60)
+ *   - the body: for raw_encoding, the filter array, capacity/CHAR_BIT
+ *     bytes; for compressed encodings (see compression.hpp), a 24-byte
+ *     encoding header (payload size in bytes, number of bits set, encoding
+ *     parameter, reserved) followed by the payload
+ *   - 64-byte trailer: CRC-32C of the body followed by zeros.
+ *
+ * Integers are stored with the native byte order of the saving machine, as
+ * is the array itself: loading on a machine with different endianness is
+ * rejected. The array lies at offset 64 so that a memory-mapped file can be
+ * viewed in place with the alignment filter_view requires, and the trailer
+ * guarantees that the bytes past the array end filter_view may read are
+ * accessible. Compressed data can't be viewed.
+ */
+
+static constexpr std::size_t serialization_header_size=64;
+static constexpr std::size_t serialization_trailer_size=64;
+static constexpr std::uint32_t serialization_version=1;
+static constexpr std::uint32_t serialization_endianness_mark=0x01020304u;
+static constexpr std::size_t serialization_chunk_size=1024*1024;
+static constexpr std::size_t serialization_encoding_header_size=24;
+
+/* Identifies the bit layout of known subfilters, 0 for unknown ones (which
+ * are then identified only by their sizes and k). Implementations of
+ * fast_multiblock32 and fast_multiblock64 are given the same id when they
+ * produce the same arrays.
+ */
+
+template<typename Subfilter>
+struct subfilter_id:std::integral_constant<std::uint32_t,0>{};
+
+template<typename Block,std::size_t K>
+struct subfilter_id<block<Block,K>>:std::integral_constant<std::uint32_t,1>{};
+
+template<typename Block,std::size_t K>
+struct subfilter_id<multiblock<Block,K>>:
+  std::integral_constant<std::uint32_t,2>{};
+
+#if defined(BOOST_BLOOM_AVX512)||defined(BOOST_BLOOM_AVX2)
+template<std::size_t K>
+struct subfilter_id<fast_multiblock32<K>>:
+  std::integral_constant<std::uint32_t,3>{};
+#elif defined(BOOST_BLOOM_SSE2)
+template<std::size_t K>
+struct subfilter_id<fast_multiblock32<K>>:
+  std::integral_constant<std::uint32_t,5>{};
+#elif defined(BOOST_BLOOM_LITTLE_ENDIAN_NEON)
+template<std::size_t K>
+struct subfilter_id<fast_multiblock32<K>>:
+  std::integral_constant<std::uint32_t,6>{};
+#endif /* otherwise, fast_multiblock32 is multiblock<std::uint32_t,K> */
+
+template<std::size_t K>
+struct subfilter_id<dispatched_fast_multiblock32<K>>:
+  std::integral_constant<std::uint32_t,3>{};
+
+template<std::size_t K>
+struct subfilter_id<fast_multiblock64<K>>:
+  std::integral_constant<std::uint32_t,4>{};
+
+template<std::size_t K>
+struct subfilter_id<dispatched_fast_multiblock64<K>>:
+  std::integral_constant<std::uint32_t,4>{};
+
+struct serialization_header
+{
+  std::uint64_t capacity;
+  std::uint32_t k;
+  std::uint32_t subfilter_id;
+  std::uint32_t subfilter_k;
+  std::uint32_t block_size;
+  std::uint32_t used_value_size;
+  std::uint32_t stride;
+  std::uint64_t hash_id;
+  std::uint32_t flags;
+  std::uint32_t encoding;
+};
+
+template<typename Subfilter,std::size_t Stride,typename Hash>
+serialization_header make_serialization_header(
+  std::size_t k,std::size_t capacity,std::uint64_t hash_id)
+{
+  return {
+    capacity,(std::uint32_t)k,
+    subfilter_id<Subfilter>::value,
+    (std::uint32_t)Subfilter::k,
+    (std::uint32_t)sizeof(typename Subfilter::value_type),
+    (std::uint32_t)used_value_size<Subfilter>::value,
+    (std::uint32_t)Stride,
+    hash_id,
+    boost::hash_is_avalanching<Hash>::value&&
+    sizeof(std::size_t)>=sizeof(std::uint64_t)?0u:1u,
+    raw_encoding
+  };
+}
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
+>
+serialization_header make_serialization_header(
+  const filter<T,K,SF,S,H,A>& f,std::uint64_t hash_id)
+{
+  return make_serialization_header<SF,filter<T,K,SF,S,H,A>::stride,H>(
+    K,f.capacity(),hash_id);
+}
+
+template<typename T,typename SF,std::size_t S,typename H,typename A>
+serialization_header make_serialization_header(
+  const dynamic_filter<T,SF,S,H,A>& f,std::uint64_t hash_id)
+{
+  return make_serialization_header<SF,dynamic_filter<T,SF,S,H,A>::stride,H>(
+    f.k(),f.capacity(),hash_id);
+}
+
+template<typename T,std::size_t K,typename SF,std::size_t S,typename H>
+serialization_header make_serialization_header(
+  const filter_view<T,K,SF,S,H>& f,std::uint64_t hash_id)
+{
+  return make_serialization_header<SF,filter_view<T,K,SF,S,H>::stride,H>(
+    K,f.capacity(),hash_id);
+}
+
+template<typename UInt>
+void store_uint(unsigned char* p,UInt x)
+{
+  std::memcpy(p,&x,sizeof(x));
+}
+
+template<typename UInt>
+UInt load_uint(const unsigned char* p)
+{
+  UInt x;
+  std::memcpy(&x,p,sizeof(x));
+  return x;
+}
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline void encode_serialization_header(
+  const serialization_header& h,unsigned char* p)
+{
+  std::memcpy(p,"BOOSTBLM",8);
+  store_uint(p+8,serialization_version);
+  store_uint(p+12,serialization_endianness_mark);
+  store_uint(p+16,h.capacity);
+  store_uint(p+24,h.k);
+  store_uint(p+28,h.subfilter_id);
+  store_uint(p+32,h.subfilter_k);
+  store_uint(p+36,h.block_size);
+  store_uint(p+40,h.used_value_size);
+  store_uint(p+44,h.stride);
+  store_uint(p+48,h.hash_id);
+  store_uint(p+56,h.flags|(h.encoding<<8));
+  store_uint(p+60,crc32c(0,p,60));
+}
+
+BOOST_NORETURN inline void throw_serialization_error(const char* msg)
+{
+  BOOST_THROW_EXCEPTION(std::runtime_error(msg));
+}
+
+/* Decodes the header at p and checks that it is compatible with
+ * expected. If dynamic_k, any value of k is accepted.
+ */
+
+/* NOLINTNEXTLINE(readability-redundant-inline-specifier) */
+inline serialization_header decode_serialization_header(
+  const unsigned char* p,const serialization_header& expected,bool dynamic_k)
+{
+  if(std::memcmp(p,"BOOSTBLM",8)!=0){
+    throw_serialization_error("not a serialized Bloom filter");
+  }
+  if(load_uint<std::uint32_t>(p+60)!=crc32c(0,p,60)){
+    throw_serialization_error("corrupted header");
+  }
+  if(load_uint<std::uint32_t>(p+8)!=serialization_version){
+    throw_serialization_error("unsupported format version");
+  }
+  if(load_uint<std::uint32_t>(p+12)!=serialization_endianness_mark){
+    throw_serialization_error("incompatible endianness");
+  }
+
+  serialization_header h;
+  h.capacity=load_uint<std::uint64_t>(p+16);
+  h.k=load_uint<std::uint32_t>(p+24);
+  h.subfilter_id=load_uint<std::uint32_t>(p+28);
+  h.subfilter_k=load_uint<std::uint32_t>(p+32);
+  h.block_size=load_uint<std::uint32_t>(p+36);
+  h.used_value_size=load_uint<std::uint32_t>(p+40);
+  h.stride=load_uint<std::uint32_t>(p+44);
+  h.hash_id=load_uint<std::uint64_t>(p+48);
+  h.flags=load_uint<std::uint32_t>(p+56)&0xFFu;
+  h.encoding=load_uint<std::uint32_t>(p+56)>>8;
+
+  if((dynamic_k?h.k==0:h.k!=expected.k)||
+     h.subfilter_id!=expected.subfilter_id||
+     h.subfilter_k!=expected.subfilter_k||
+     h.block_size!=expected.block_size||
+     h.used_value_size!=expected.used_value_size||
+     h.stride!=expected.stride){
+    throw_serialization_error("incompatible filter configuration");
+  }
+  if(h.hash_id!=expected.hash_id||h.flags!=expected.flags){
+    throw_serialization_error("incompatible hash function");
+  }
+  if(h.encoding>rice_encoding){
+    throw_serialization_error("unsupported encoding");
+  }
+  if(h.capacity%CHAR_BIT!=0||
+     h.capacity/CHAR_BIT>(std::numeric_limits<std::size_t>::max)()-
+                         serialization_header_size-
+                         serialization_trailer_size){
+    throw_serialization_error("invalid capacity");
+  }
+  return h;
+}
+
+template<
+  typename T,std::size_t K,typename SF,std::size_t S,typename H,typename A
+>
+void prepare_for_load(
+  filter<T,K,SF,S,H,A>& f,const serialization_header& h)
+{
+  f.reset((std::size_t)h.capacity);
+}
+
+template<typename T,typename SF,std::size_t S,typename H,typename A>
+void prepare_for_load(
+  dynamic_filter<T,SF,S,H,A>& f,const serialization_header& h)
+{
+  if(f.k()==h.k)f.reset((std::size_t)h.capacity);
+  else f=dynamic_filter<T,SF,S,H,A>(
+    h.k,(std::size_t)h.capacity,f.hash_function(),f.get_allocator());
+}
+
+template<typename Filter>
+struct has_dynamic_k:std::false_type{};
+
+template<typename T,typename SF,std::size_t S,typename H,typename A>
+struct has_dynamic_k<dynamic_filter<T,SF,S,H,A>>:std::true_type{};
+
+} /* namespace detail */
+
+/* Filter is filter or dynamic_filter. hash_id is a user-chosen tag for
+ * the hash function, which can't be identified from its type: it is
+ * required rather than defaulted so that filters with different hash
+ * functions don't produce identical headers by omission.
+ */
+
+template<typename Filter>
+void save(const Filter& f,std::ostream& os,std::uint64_t hash_id)
+{
+  unsigned char buf[detail::serialization_header_size];
+  detail::encode_serialization_header(
+    detail::make_serialization_header(f,hash_id),buf);
+  os.write(reinterpret_cast<const char*>(buf),sizeof(buf));
+
+  auto          s=f.array();
+  std::uint32_t crc=0;
+  for(std::size_t i=0;i<s.size();i+=detail::serialization_chunk_size){
+    auto n=(std::min)(detail::serialization_chunk_size,s.size()-i);
+    crc=detail::crc32c(crc,s.data()+i,n);
+    os.write(reinterpret_cast<const char*>(s.data()+i),(std::streamsize)n);
+  }
+
+  unsigned char trailer[detail::serialization_trailer_size]={};
+  detail::store_uint(trailer,crc);
+  os.write(reinterpret_cast<const char*>(trailer),sizeof(trailer));
+  if(!os)detail::throw_serialization_error("write error");
+}
+
+/* Same as save, with the array compressed if this results in smaller
+ * output.
+ */
+
+template<typename Filter>
+void save_compressed(
+  const Filter& f,std::ostream& os,std::uint64_t hash_id)
+{
+  auto s=f.array();
+  auto c=detail::choose_encoding(
+    s.data(),s.size(),detail::serialization_encoding_header_size);
+  if(c.encoding==detail::raw_encoding){
+    save(f,os,hash_id);
+    return;
+  }
+
+  auto h=detail::make_serialization_header(f,hash_id);
+  h.encoding=c.encoding;
+  unsigned char buf[detail::serialization_header_size];
+  detail::encode_serialization_header(h,buf);
+  os.write(reinterpret_cast<const char*>(buf),sizeof(buf));
+
+  detail::chunked_output out(os);
+  unsigned char          ebuf[detail::serialization_encoding_header_size]={};
+  detail::store_uint(ebuf,c.payload_size);
+  detail::store_uint(ebuf+8,c.num_ones);
+  detail::store_uint(ebuf+16,c.parameter);
+  out.write(ebuf,sizeof(ebuf));
+  if(c.encoding==detail::sparse_encoding){
+    detail::encode_sparse(s.data(),s.size(),out);
+  }
+  else{
+    detail::encode_rice(s.data(),s.size(),c.parameter,out);
+  }
+  out.flush();
+
+  unsigned char trailer[detail::serialization_trailer_size]={};
+  detail::store_uint(trailer,out.checksum());
+  os.write(reinterpret_cast<const char*>(trailer),sizeof(trailer));
+  if(!os)detail::throw_serialization_error("write error");
+}
+
+template<typename Filter>
+void load(Filter& f,std::istream& is,std::uint64_t hash_id)
+{
+  unsigned char buf[detail::serialization_header_size];
+  if(!is.read(reinterpret_cast<char*>(buf),sizeof(buf))){
+    detail::throw_serialization_error("read error");
+  }
+  auto h=detail::decode_serialization_header(
+    buf,detail::make_serialization_header(f,hash_id),
+    detail::has_dynamic_k<Filter>::value);
+  detail::prepare_for_load(f,h);
+  if(f.capacity()!=h.capacity){
+    f.reset();
+    detail::throw_serialization_error("invalid capacity");
+  }
+
+  /* read or decode directly into the filter's array, chunk by chunk */
+
+  auto          s=f.array();
+  std::uint32_t crc=0;
+  if(h.encoding==detail::raw_encoding){
+    for(std::size_t i=0;i<s.size();i+=detail::serialization_chunk_size){
+      auto n=(std::min)(detail::serialization_chunk_size,s.size()-i);
+      if(!is.read(reinterpret_cast<char*>(s.data()+i),(std::streamsize)n)){
+        f.reset();
+        detail::throw_serialization_error("read error");
+      }
+      crc=detail::crc32c(crc,s.data()+i,n);
+    }
+  }
+  else BOOST_TRY{
+    unsigned char ebuf[detail::serialization_encoding_header_size];
+    if(!is.read(reinterpret_cast<char*>(ebuf),sizeof(ebuf))){
+      detail::throw_serialization_error("read error");
+    }
+    crc=detail::crc32c(0,ebuf,sizeof(ebuf));
+
+    auto payload_size=detail::load_uint<std::uint64_t>(ebuf);
+    auto num_ones=detail::load_uint<std::uint64_t>(ebuf+8);
+    auto parameter=detail::load_uint<std::uint32_t>(ebuf+16);
+    detail::chunked_input in(is,payload_size,crc);
+    if(h.encoding==detail::sparse_encoding){
+      detail::decode_sparse(s.data(),s.size(),num_ones,in);
+    }
+    else{
+      detail::decode_rice(s.data(),s.size(),num_ones,parameter,in);
+    }
+    crc=in.checksum();
+  }
+  BOOST_CATCH(...){
+    f.reset();
+    BOOST_RETHROW
+  }
+  BOOST_CATCH_END
+
+  unsigned char trailer[detail::serialization_trailer_size];
+  if(!is.read(reinterpret_cast<char*>(trailer),sizeof(trailer))){
+    f.reset();
+    detail::throw_serialization_error("read error");
+  }
+  if(detail::load_uint<std::uint32_t>(trailer)!=crc){
+    f.reset();
+    detail::throw_serialization_error("corrupted array");
+  }
+}
+
+/* FilterView is a filter_view */
+
+template<typename FilterView>
+FilterView load_view(
+  boost::span<const unsigned char> x,std::uint64_t hash_id,
+  bool verify_checksum=true)
+{
+  if(x.size()<detail::serialization_header_size){
+    detail::throw_serialization_error("read error");
+  }
+  auto h=detail::decode_serialization_header(
+    x.data(),detail::make_serialization_header(FilterView{},hash_id),false);
+  if(h.encoding!=detail::raw_encoding){
+    detail::throw_serialization_error("compressed data can't be viewed");
+  }
+  auto n=(std::size_t)(h.capacity/CHAR_BIT);
+  if(x.size()<
+     detail::serialization_header_size+n+detail::serialization_trailer_size){
+    detail::throw_serialization_error("read error");
+  }
+
+  auto s=x.subspan(detail::serialization_header_size,n);
+  if(verify_checksum){
+    std::uint32_t crc=0;
+    for(std::size_t i=0;i<n;i+=detail::serialization_chunk_size){
+      crc=detail::crc32c(
+        crc,s.data()+i,(std::min)(detail::serialization_chunk_size,n-i));
+    }
+    if(detail::load_uint<std::uint32_t>(s.data()+n)!=crc){
+      detail::throw_serialization_error("corrupted array");
+    }
+  }
+  return FilterView{s};
+}
+
+} /* namespace bloom */
+} /* namespace boost */
+#endif
@@ -0,0 +1,310 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/any_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+/* single-pass iterator returning references to a value cached inside the
+ * iterator, like std::istream_iterator
+ */
+
+template<typename T>
+struct caching_input_iterator
+{
+  using iterator_category=std::input_iterator_tag;
+  using value_type=T;
+  using difference_type=std::ptrdiff_t;
+  using pointer=const T*;
+  using reference=const T&;
+
+  caching_input_iterator(const T* p_,const T* last_):p{p_},last{last_}
+  {
+    if(p!=last)x=*p;
+  }
+
+  reference operator*()const{return x;}
+  pointer operator->()const{return &x;}
+
+  caching_input_iterator& operator++()
+  {
+    if(++p!=last)x=*p;
+    return *this;
+  }
+
+  caching_input_iterator operator++(int)
+  {
+    auto res=*this;
+    ++*this;
+    return res;
+  }
+
+  friend bool operator==(
+    const caching_input_iterator& x,const caching_input_iterator& y)
+  {
+    return x.p==y.p;
+  }
+
+  friend bool operator!=(
+    const caching_input_iterator& x,const caching_input_iterator& y)
+  {
+    return !(x==y);
+  }
+
+  const T* p;
+  const T* last;
+  T        x;
+};
+
+template<typename Filter,typename ValueFactory>
+void test_any_filter()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+  using any_filter=boost::bloom::any_filter<value_type>;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<2000;++i)input.push_back(fac());
+  std::list<value_type>   input_list(input.begin(),input.end());
+
+  {
+    any_filter af;
+    BOOST_TEST(!af);
+    BOOST_TEST(af.target_type()==BOOST_CORE_TYPEID(void));
+    BOOST_TEST(af.template target<filter>()==nullptr);
+  }
+
+  filter     f(10000);
+  any_filter af(filter{10000});
+  BOOST_TEST(!!af);
+  BOOST_TEST(af.target_type()==BOOST_CORE_TYPEID(filter));
+  BOOST_TEST(af.template target<filter>()!=nullptr);
+  using other_filter=boost::bloom::filter<value_type,13>;
+  BOOST_TEST(af.template target<other_filter>()==nullptr);
+  BOOST_TEST_EQ(af.capacity(),f.capacity());
+
+  /* element by element, contiguous range and list (non-contiguous range) */
+
+  for(std::size_t i=0;i<100;++i){
+    BOOST_TEST_EQ(af.try_insert(input[i]),f.try_insert(input[i]));
+  }
+  f.insert(input.begin()+100,input.begin()+1000);
+  af.insert(input.begin()+100,input.begin()+1000);
+  BOOST_TEST(same_array(f,af));
+  f.insert(input_list.begin(),input_list.end());
+  af.insert(input_list.begin(),input_list.end());
+  BOOST_TEST(same_array(f,af));
+  BOOST_TEST(*af.template target<filter>()==f);
+  BOOST_TEST_EQ(af.estimated_size(),f.estimated_size());
+  BOOST_TEST_EQ(af.estimated_fpr(),f.estimated_fpr());
+
+  std::size_t n=0;
+
+  /* ranges of values convertible to value_type are copied chunk-wise */
+
+  {
+    std::vector<std::reference_wrapper<const value_type>> refs(
+      input.begin(),input.end());
+
+    filter     f2(10000);
+    any_filter af2(filter{10000});
+    f2.insert(input.begin(),input.end());
+    af2.insert(refs.begin(),refs.end());
+    BOOST_TEST(same_array(f2,af2));
+
+    n=0;
+    af2.may_contain(
+      refs.begin(),refs.end(),
+      [&](const value_type& x,bool res){
+        BOOST_TEST(res);
+        BOOST_TEST(x==input[n++]);
+      });
+    BOOST_TEST_EQ(n,input.size());
+  }
+
+  /* single-pass ranges */
+
+  {
+    using iterator=caching_input_iterator<value_type>;
+
+    auto first=input.data(),last=input.data()+input.size();
+
+    filter     f2(10000);
+    any_filter af2(filter{10000});
+    f2.insert(input.begin(),input.end());
+    af2.insert(iterator{first,last},iterator{last,last});
+    BOOST_TEST(same_array(f2,af2));
+
+    n=0;
+    af2.may_contain(
+      iterator{first,last},iterator{last,last},
+      [&](const value_type& x,bool res){
+        BOOST_TEST(res);
+        BOOST_TEST(x==input[n++]);
+      });
+    BOOST_TEST_EQ(n,input.size());
+  }
+
+  std::vector<value_type> lookup_input=input;
+  for(int i=0;i<2000;++i)lookup_input.push_back(fac());
+
+  for(const auto& x:lookup_input){
+    BOOST_TEST_EQ(af.may_contain(x),f.may_contain(x));
+    BOOST_TEST_EQ(
+      af.may_contain_hash(af.hash_for(x)),f.may_contain_hash(f.hash_for(x)));
+  }
+  n=0;
+  af.may_contain(
+    lookup_input.begin(),lookup_input.end(),
+    [&](const value_type& x,bool res){
+      BOOST_TEST_EQ(res,f.may_contain(x));
+      ++n;
+    });
+  BOOST_TEST_EQ(n,lookup_input.size());
+
+  std::vector<std::uint64_t> hashes;
+  for(const auto& x:lookup_input)hashes.push_back(f.hash_for(x));
+  n=0;
+  af.may_contain_hash(
+    hashes.begin(),hashes.end(),[&](std::uint64_t h,bool res){
+      BOOST_TEST_EQ(res,f.may_contain_hash(h));
+      ++n;
+    });
+  BOOST_TEST_EQ(n,hashes.size());
+
+  {
+    std::vector<std::uint64_t> bitmap1((lookup_input.size()+63)/64),
+                               bitmap2(bitmap1.size());
+    BOOST_TEST_EQ(
+      af.may_contain_bitmap(lookup_input,bitmap1.data()),
+      f.may_contain_bitmap(lookup_input,bitmap2.data()));
+    BOOST_TEST(bitmap1==bitmap2);
+    BOOST_TEST_EQ(
+      af.may_contain_hash_bitmap(hashes,bitmap1.data()),
+      f.may_contain_hash_bitmap(hashes,bitmap2.data()));
+    BOOST_TEST(bitmap1==bitmap2);
+
+    std::vector<std::uint32_t> selection1(lookup_input.size()),
+                               selection2(lookup_input.size());
+    std::size_t n1=af.may_contain_selection(lookup_input,selection1.data()),
+                n2=f.may_contain_selection(lookup_input,selection2.data());
+    BOOST_TEST_EQ(n1,n2);
+    BOOST_TEST(std::memcmp(
+      selection1.data(),selection2.data(),n1*sizeof(std::uint32_t))==0);
+    n1=af.may_contain_hash_selection(hashes,selection1.data());
+    n2=f.may_contain_hash_selection(hashes,selection2.data());
+    BOOST_TEST_EQ(n1,n2);
+    BOOST_TEST(std::memcmp(
+      selection1.data(),selection2.data(),n1*sizeof(std::uint32_t))==0);
+  }
+
+  /* hash-level insertion */
+
+  {
+    filter     f2(10000);
+    any_filter af2(filter{10000});
+    for(std::size_t i=0;i<100;++i){
+      BOOST_TEST_EQ(
+        af2.try_insert_hash(hashes[i]),f2.try_insert_hash(hashes[i]));
+    }
+    f2.insert_hash(hashes.begin()+100,hashes.end());
+    af2.insert_hash(hashes.begin()+100,hashes.end());
+    BOOST_TEST(same_array(f2,af2));
+  }
+
+  /* copy, move, assignment, swap */
+
+  {
+    any_filter af2(af);
+    BOOST_TEST(same_array(f,af2));
+    BOOST_TEST(af2.array().data()!=af.array().data());
+    any_filter af3(std::move(af2));
+    BOOST_TEST(!af2);
+    BOOST_TEST(same_array(f,af3));
+    af3.clear();
+    BOOST_TEST(*af3.template target<filter>()==filter(10000));
+    af3=af;
+    BOOST_TEST(same_array(f,af3));
+    af2=f;
+    BOOST_TEST(same_array(f,af2));
+    af3=filter{};
+    BOOST_TEST_EQ(af3.capacity(),0u);
+    swap(af2,af3);
+    BOOST_TEST_EQ(af2.capacity(),0u);
+    BOOST_TEST(same_array(f,af3));
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_any_filter<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+
+  /* std::istream_iterator<int> returns references to its cached value */
+
+  {
+    using iterator=std::istream_iterator<int>;
+    using filter=boost::bloom::filter<int,5>;
+
+    filter                        f(1000);
+    boost::bloom::any_filter<int> af(filter{1000});
+    std::istringstream            is("1 2 3 4 5 6 7 8 9 10");
+    af.insert(iterator{is},iterator{});
+    for(int i=1;i<=10;++i){
+      f.insert(i);
+      BOOST_TEST(af.may_contain(i));
+    }
+    BOOST_TEST(*af.target<filter>()==f);
+
+    int i=0;
+    is.clear();
+    is.str("1 2 3 4 5 6 7 8 9 10");
+    af.may_contain(iterator{is},iterator{},[&](int x,bool res){
+      BOOST_TEST_EQ(x,++i);
+      BOOST_TEST(res);
+    });
+    BOOST_TEST_EQ(i,10);
+  }
+
+  /* same any_filter type for different configurations */
+
+  boost::bloom::any_filter<int> af(boost::bloom::filter<int,2>{1000});
+  af.insert({1,2,3});
+  BOOST_TEST(af.may_contain(1));
+  af=boost::bloom::dynamic_filter<int,boost::bloom::block<std::uint64_t,3>>{
+    4,1000};
+  BOOST_TEST(!af.may_contain(1));
+  af.insert({1,2,3});
+  BOOST_TEST(af.may_contain(1));
+
+  return boost::report_errors();
+}
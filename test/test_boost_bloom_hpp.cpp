@@ -16,6 +16,14 @@ struct use_types
   using type3=boost::bloom::multiblock<unsigned char,1>;
   using type4=boost::bloom::fast_multiblock32<1>;
   using type5=boost::bloom::fast_multiblock64<1>;
+  using type6=boost::bloom::concurrent_filter<int,1>;
+  using type7=boost::bloom::dynamic_filter<int>;
+  using type8=boost::bloom::any_filter<int>;
+  using type9=boost::bloom::filter_view<int,1>;
+  using type10=boost::bloom::huge_page_allocator<>;
+  using type11=boost::bloom::numa_filter<int,1>;
+  using type12=boost::bloom::counting_filter<int,1>;
+  using type13=boost::bloom::cuckoo_filter<int,12>;
 };
 
 int main()
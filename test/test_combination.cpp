@@ -6,6 +6,10 @@
  * See https://www.boost.org/libs/bloom for library home page.
  */
 
+/* exercise both regular and non-temporal combination */
+
+#define BOOST_BLOOM_NONTEMPORAL_COMBINE_THRESHOLD 4096
+
 #include <boost/core/lightweight_test.hpp>
 #include <boost/mp11/algorithm.hpp>
 #include <vector>
@@ -96,6 +100,44 @@ void test_combination()
     BOOST_TEST(may_contain(f1,input1));
     BOOST_TEST(may_contain(f1,input2));
   }
+
+  /* array sizes around vector widths and non-temporal threshold */
+
+  for(std::size_t m:{
+    (std::size_t)100,(std::size_t)1000,(std::size_t)4096*8+7*8,
+    (std::size_t)10000*8}){
+    filter f1{input1.begin(),input1.end(),m},
+           f2{input2.begin(),input2.end(),m},
+           f3{f1};
+
+    f1.insert(input2.begin(),input2.end());
+    f3|=f2;
+    BOOST_TEST(f1==f3);
+    f3&=f2;
+    BOOST_TEST(f3==f2);
+  }
+
+  /* parallel combination */
+
+  {
+    filter      f1{input1.begin(),input1.end(),(std::size_t)10000000*8},
+                f2{input2.begin(),input2.end(),f1.capacity()},
+                f3{f1},f4{f1};
+    std::size_t num_threads[]={0,1,2,3,8};
+
+    f3|=f2;
+    f4&=f2;
+    for(auto nt:num_threads){
+      filter f{f1};
+      BOOST_TEST_EQ(&f.parallel_or(f2,nt),&f);
+      BOOST_TEST(f==f3);
+      f=f1;
+      BOOST_TEST_EQ(&f.parallel_and(f2,nt),&f);
+      BOOST_TEST(f==f4);
+    }
+    BOOST_TEST_THROWS(f1.parallel_or(filter{},2),std::invalid_argument);
+    BOOST_TEST_THROWS(f1.parallel_and(filter{},2),std::invalid_argument);
+  }
 }
 
 struct lambda
@@ -0,0 +1,116 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/concurrent_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_concurrent()
+{
+  using filter=Filter;
+  using concurrent_filter=
+    retemplate_filter<filter,boost::bloom::concurrent_filter>;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<10000;++i)input.push_back(fac());
+
+  /* same layout as filter */
+
+  {
+    filter            f(20000);
+    concurrent_filter cf(f.capacity());
+    BOOST_TEST_EQ(cf.capacity(),f.capacity());
+
+    for(std::size_t i=0;i<input.size()/2;++i){
+      BOOST_TEST_EQ(cf.try_insert(input[i]),f.try_insert(input[i]));
+    }
+    f.insert(input.begin()+input.size()/2,input.end()-100);
+    cf.insert(input.begin()+input.size()/2,input.end()-100);
+    BOOST_TEST(same_array(f,cf));
+
+    for(const auto& x:input)BOOST_TEST_EQ(cf.may_contain(x),f.may_contain(x));
+    cf.may_contain(input.begin(),input.end(),[&](const value_type& x,bool res){
+      BOOST_TEST_EQ(res,f.may_contain(x));
+    });
+
+    concurrent_filter cf2(cf);
+    BOOST_TEST(cf2==cf);
+    cf2.clear();
+    BOOST_TEST(cf2!=cf);
+  }
+  {
+    concurrent_filter cf;
+    BOOST_TEST(!cf.try_insert(input[0]));
+    cf.insert(input.begin(),input.end());
+    BOOST_TEST(cf==concurrent_filter{});
+    BOOST_TEST(cf.may_contain(input[0]));
+  }
+
+  /* concurrent insertion with small capacities to maximize contention */
+
+  for(std::size_t m:{(std::size_t)1000,(std::size_t)100000}){
+    filter            f(m);
+    concurrent_filter cf(f.capacity());
+    f.insert(input.begin(),input.end());
+
+    const std::size_t        num_threads=8;
+    std::atomic<std::size_t> num_positives{0};
+    std::vector<std::thread> threads;
+    for(std::size_t t=0;t<num_threads;++t){
+      threads.emplace_back([&,t]{
+        auto first=input.begin()+t*input.size()/num_threads,
+             last=input.begin()+(t+1)*input.size()/num_threads;
+        auto mid=first+(last-first)/2;
+        for(auto it=first;it!=mid;++it){
+          if(t%2)cf.insert(*it);
+          else   cf.try_insert(*it);
+        }
+        cf.insert(mid,last);
+
+        /* concurrent lookup */
+
+        std::size_t res=0;
+        for(const auto& x:input)res+=cf.may_contain(x);
+        num_positives+=res;
+      });
+    }
+    for(auto& th:threads)th.join();
+
+    BOOST_TEST(same_array(f,cf));
+    BOOST_TEST(may_contain(cf,input));
+    BOOST_TEST_GT(num_positives.load(),0u);
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_concurrent<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
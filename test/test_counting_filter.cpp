@@ -0,0 +1,242 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/counting_filter.hpp>
+#include <boost/core/bit.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename CountingFilter>
+bool has_saturated_counters(const CountingFilter& cf)
+{
+  static constexpr std::size_t bits=CountingFilter::counter_bits;
+
+  for(auto c:cf.array()){
+    for(std::size_t i=0;i<8;i+=bits){
+      if(((c>>i)&((1u<<bits)-1))==(1u<<bits)-1)return true;
+    }
+  }
+  return false;
+}
+
+template<typename Filter,std::size_t CounterBits,typename ValueFactory>
+void test_counting_filter()
+{
+  using filter=Filter;
+  using counting_filter=counting_filter_for<filter,CounterBits>;
+  using value_type=typename filter::value_type;
+
+  static constexpr std::size_t max_count=(1u<<CounterBits)-1;
+
+  ValueFactory            fac;
+  std::vector<value_type> input,extra_input;
+  for(int i=0;i<1000;++i)input.push_back(fac());
+  for(int i=0;i<1000;++i)extra_input.push_back(fac());
+
+  {
+    counting_filter cf;
+    BOOST_TEST_EQ(cf.capacity(),0u);
+    BOOST_TEST(cf.array().data()==nullptr);
+    BOOST_TEST(may_contain(cf,input));
+    cf.insert(input[0]);
+    cf.erase(input[0]);
+    cf.insert(input.begin(),input.end());
+    cf.erase(input.begin(),input.end());
+    BOOST_TEST(cf.to_filter()==filter{});
+    BOOST_TEST(may_contain(cf,input));
+  }
+
+  counting_filter cf(10000);
+  filter          f(10000);
+  BOOST_TEST_EQ(cf.capacity(),f.capacity());
+  BOOST_TEST_EQ(
+    cf.array().size(),f.array().size()*counting_filter::counter_bits);
+  BOOST_TEST_EQ(
+    counting_filter::capacity_for(1000,0.01),filter::capacity_for(1000,0.01));
+  for(const auto& x:input)BOOST_TEST_EQ(cf.hash_for(x),f.hash_for(x));
+
+  /* projection matches the filter with the elements not erased */
+
+  f.insert(input.begin(),input.end());
+  cf.insert(input.begin(),input.end());
+  BOOST_TEST(may_contain(cf,input));
+  BOOST_TEST(cf.to_filter()==f);
+  cf.insert(extra_input.begin(),extra_input.end());
+  BOOST_TEST(may_contain(cf,extra_input));
+  cf.erase(extra_input.begin(),extra_input.end());
+  BOOST_TEST(may_contain(cf,input));
+  BOOST_TEST(cf.to_filter()==f);
+  for(const auto& x:extra_input){
+    BOOST_TEST_EQ(cf.may_contain(x),f.may_contain(x));
+  }
+  if(!has_saturated_counters(cf)){
+    counting_filter cf2(cf);
+    cf2.erase(input.begin(),input.end());
+    BOOST_TEST(cf2==counting_filter(cf.capacity()));
+    BOOST_TEST(cf2.to_filter()==filter(f.capacity()));
+  }
+
+  /* bulk insertion and erasure match element-wise operations */
+
+  for(std::size_t n:{0,1,7,63,65,1000}){
+    counting_filter cf2(cf.capacity()),cf3(cf.capacity());
+    cf2.insert(input.begin(),input.begin()+n);
+    for(std::size_t i=0;i<n;++i)cf3.insert(input[i]);
+    BOOST_TEST(cf2==cf3);
+    cf2.erase(input.begin(),input.begin()+n/2);
+    for(std::size_t i=0;i<n/2;++i)cf3.erase(input[i]);
+    BOOST_TEST(cf2==cf3);
+  }
+
+  /* erasing from zero counters doesn't underflow */
+
+  {
+    counting_filter cf2(cf.capacity());
+    cf2.erase(input.begin(),input.end());
+    BOOST_TEST(cf2==counting_filter(cf.capacity()));
+  }
+
+  /* saturated counters are never decremented */
+
+  {
+    counting_filter cf2(cf.capacity());
+    for(std::size_t i=0;i<max_count-1;++i)cf2.insert(input[0]);
+    for(std::size_t i=0;i<max_count-1;++i)cf2.erase(input[0]);
+    BOOST_TEST(cf2==counting_filter(cf.capacity()));
+    for(std::size_t i=0;i<max_count+1;++i)cf2.insert(input[0]);
+    for(std::size_t i=0;i<max_count+1;++i)cf2.erase(input[0]);
+    BOOST_TEST(cf2.may_contain(input[0]));
+    BOOST_TEST(cf2!=counting_filter(cf.capacity()));
+  }
+
+  /* copy, move, assignment, swap, clear and reset */
+
+  {
+    counting_filter cf2(cf);
+    BOOST_TEST(cf2==cf);
+    counting_filter cf3(std::move(cf2));
+    BOOST_TEST(cf3==cf);
+    BOOST_TEST_EQ(cf2.capacity(),0u);
+    cf2=cf3;
+    BOOST_TEST(cf2==cf);
+    cf3=counting_filter{};
+    BOOST_TEST_EQ(cf3.capacity(),0u);
+    swap(cf2,cf3);
+    BOOST_TEST(cf3==cf);
+    BOOST_TEST(cf2!=cf);
+    cf3.clear();
+    BOOST_TEST(cf3==counting_filter(cf.capacity()));
+    cf3.reset(cf.capacity()*2);
+    BOOST_TEST_GE(cf3.capacity(),cf.capacity()*2);
+    BOOST_TEST(cf3==counting_filter(cf3.capacity()));
+    cf3.reset();
+    BOOST_TEST_EQ(cf3.capacity(),0u);
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_counting_filter<filter,4,value_factory<value_type>>();
+    test_counting_filter<filter,8,value_factory<value_type>>();
+  }
+};
+
+/* Checks the (possibly SIMD) counter operations against a plain model,
+ * with counter j in byte j (8 bits) or in the low/high nibble of
+ * byte j/2 (4 bits), which is the layout on little-endian platforms.
+ */
+
+template<std::size_t CounterBits,std::size_t N>
+void test_counter_ops()
+{
+  using ops=boost::bloom::detail::counter_ops<CounterBits>;
+
+  static constexpr unsigned max_count=(1u<<CounterBits)-1;
+
+  auto counter=[](const unsigned char* p,std::size_t j)->unsigned{
+    return CounterBits==8?p[j]:(p[j/2]>>(4*(j%2)))&0x0Fu;
+  };
+
+  std::mt19937               gen;
+  std::vector<unsigned char> counters(N*CounterBits,0);
+  std::vector<unsigned>      model(N*8,0);
+  for(int i=0;i<20000;++i){
+    /* masks from sparse to dense */
+
+    unsigned char m[N];
+    for(std::size_t j=0;j<N;++j){
+      m[j]=(unsigned char)gen();
+      if(i%3)m[j]&=(unsigned char)gen();
+      if(i%3==2)m[j]&=(unsigned char)gen();
+    }
+
+    bool expected=true;
+    for(std::size_t j=0;j<N*8;++j){
+      if((m[j/8]>>(j%8))&1u){
+        if(model[j]==0)expected=false;
+      }
+    }
+    BOOST_TEST_EQ((ops::template check<N>(counters.data(),m)),expected);
+
+    /* more increments than decrements so as to reach saturation */
+
+    bool inc=gen()%8<5;
+    if(inc)ops::template increment<N>(counters.data(),m);
+    else   ops::template decrement<N>(counters.data(),m);
+    for(std::size_t j=0;j<N*8;++j){
+      if(!((m[j/8]>>(j%8))&1u))continue;
+      if(inc){
+        if(model[j]<max_count)++model[j];
+      }
+      else if(model[j]!=0&&model[j]!=max_count)--model[j];
+    }
+
+    if(boost::core::endian::native==boost::core::endian::little){
+      for(std::size_t j=0;j<N*8;++j){
+        BOOST_TEST_EQ(counter(counters.data(),j),model[j]);
+      }
+    }
+    for(std::size_t j=0;j<N;++j){
+      unsigned char projection=0;
+      for(std::size_t l=0;l<8;++l){
+        if(model[j*8+l])projection|=(unsigned char)(1u<<l);
+      }
+      BOOST_TEST_EQ(
+        (unsigned)ops::project(counters.data()+j*CounterBits),
+        (unsigned)projection);
+    }
+  }
+}
+
+int main()
+{
+  test_counter_ops<4,1>();
+  test_counter_ops<4,8>();
+  test_counter_ops<4,20>();
+  test_counter_ops<8,1>();
+  test_counter_ops<8,8>();
+  test_counter_ops<8,18>();
+
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
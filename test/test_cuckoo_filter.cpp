@@ -0,0 +1,223 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/cuckoo_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <boost/mp11/utility.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+using test_types=boost::mp11::mp_list<
+  boost::bloom::cuckoo_filter<int,8>,
+  boost::bloom::cuckoo_filter<std::string,12>,
+  boost::bloom::cuckoo_filter<std::size_t,16>,
+  boost::bloom::cuckoo_filter<int,7,8>,
+  boost::bloom::cuckoo_filter<std::string,13,3>,
+  boost::bloom::cuckoo_filter<int,16,2>,
+  boost::bloom::cuckoo_filter<std::size_t,32,2>,
+  boost::bloom::cuckoo_filter<int,12,1>
+>;
+
+using identity_test_types=
+  boost::mp11::mp_transform<boost::mp11::mp_identity,test_types>;
+
+template<typename Filter,typename ValueFactory>
+void test_cuckoo_filter()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input,extra_input;
+  for(int i=0;i<1000;++i)input.push_back(fac());
+  for(int i=0;i<10000;++i)extra_input.push_back(fac());
+
+  {
+    filter f;
+    BOOST_TEST_EQ(f.capacity(),0u);
+    BOOST_TEST(f.array().data()==nullptr);
+    BOOST_TEST(!f.may_contain(input[0]));
+    BOOST_TEST(!f.insert(input[0]));
+    BOOST_TEST(!f.erase(input[0]));
+    BOOST_TEST_EQ(f.size(),0u);
+
+    /* the shared dummy array is not written to */
+
+    filter f2(f);
+    f2.clear();
+    BOOST_TEST(f2==f);
+    BOOST_TEST_EQ(f2.capacity(),0u);
+    BOOST_TEST(f2.array().data()==nullptr);
+    BOOST_TEST(!f2.may_contain(input[0]));
+  }
+
+  filter f(input.size(),0.01);
+  BOOST_TEST_LE(
+    (double)input.size()/(f.capacity()/filter::fingerprint_bits),
+    filter::max_load_factor());
+  BOOST_TEST(f.insert(input.begin(),input.end()));
+  BOOST_TEST_EQ(f.size(),input.size());
+  BOOST_TEST(may_contain(f,input));
+  BOOST_TEST(may_not_contain(f,extra_input));
+  {
+    std::size_t res=0;
+    f.may_contain(
+      extra_input.begin(),extra_input.end(),
+      [&](const value_type& x,bool b){
+        BOOST_TEST_EQ(b,f.may_contain(x));
+        res+=b;
+      });
+
+    /* generous bound for the fpr */
+
+    BOOST_TEST_LE(
+      (double)res/extra_input.size(),
+      3*filter::fpr_for(input.size(),f.capacity())+0.001);
+  }
+
+  /* erase removes a single copy */
+
+  {
+    filter f2(f);
+    BOOST_TEST(f2.insert(input[0]));
+    BOOST_TEST_EQ(f2.size(),input.size()+1);
+    BOOST_TEST(f2.erase(input[0]));
+    BOOST_TEST(f2.may_contain(input[0]));
+    BOOST_TEST_EQ(f2.size(),input.size());
+    BOOST_TEST_EQ(f2.erase(input.begin(),input.end()),input.size());
+    BOOST_TEST_EQ(f2.size(),0u);
+    BOOST_TEST(f2==filter(f.capacity()));
+  }
+
+  /* fill to failure: failed insertions leave the filter unchanged */
+
+  {
+    filter      f2(input.size()*filter::fingerprint_bits);
+    std::size_t n=0;
+    for(const auto& x:extra_input){
+      filter f3(f2);
+      if(!f2.insert(x)){
+        BOOST_TEST(f2==f3);
+        BOOST_TEST_EQ(f2.size(),f3.size());
+        break;
+      }
+      ++n;
+    }
+    BOOST_TEST_EQ(f2.size(),n);
+    BOOST_TEST_LT(n,extra_input.size());
+    BOOST_TEST_GE(f2.load_factor(),filter::max_load_factor()*0.9);
+    BOOST_TEST(may_contain(
+      f2,std::vector<value_type>(extra_input.begin(),extra_input.begin()+n)));
+  }
+
+  /* copy, move, assignment, swap, clear and reset */
+
+  {
+    filter f2(f);
+    BOOST_TEST(f2==f);
+    filter f3(std::move(f2));
+    BOOST_TEST(f3==f);
+    BOOST_TEST_EQ(f2.capacity(),0u);
+    BOOST_TEST_EQ(f2.size(),0u);
+    f2=f3;
+    BOOST_TEST(f2==f);
+    BOOST_TEST_EQ(f2.size(),f.size());
+    f3=filter{};
+    BOOST_TEST_EQ(f3.capacity(),0u);
+    swap(f2,f3);
+    BOOST_TEST(f3==f);
+    BOOST_TEST(f2!=f);
+    f3.clear();
+    BOOST_TEST_EQ(f3.size(),0u);
+    BOOST_TEST(f3==filter(f.capacity()));
+    f3.reset(f.capacity()*2);
+    BOOST_TEST_GE(f3.capacity(),f.capacity()*2);
+    BOOST_TEST(f3==filter(f3.capacity()));
+    f3.reset();
+    BOOST_TEST_EQ(f3.capacity(),0u);
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_cuckoo_filter<filter,value_factory<value_type>>();
+  }
+};
+
+/* Checks bucket operations against a plain model of the array */
+
+template<std::size_t FingerprintBits,std::size_t BucketSize>
+void test_cuckoo_buckets()
+{
+  using buckets=
+    boost::bloom::detail::cuckoo_buckets<FingerprintBits,BucketSize>;
+
+  static constexpr std::size_t num_buckets=37;
+  static constexpr std::uint64_t mask=(std::uint64_t(1)<<FingerprintBits)-1;
+
+  std::mt19937_64            gen;
+  std::vector<unsigned char> array(
+    buckets::used_array_size(num_buckets)+buckets::tail_size,0);
+  std::vector<std::uint64_t> model(num_buckets*BucketSize,0);
+
+  auto model_find=[&](std::size_t i,std::uint64_t fp){
+    std::size_t j=0;
+    for(;j<BucketSize;++j)if(model[i*BucketSize+j]==fp)break;
+    return j;
+  };
+
+  for(int n=0;n<20000;++n){
+    std::size_t   i=(std::size_t)(gen()%num_buckets),
+                  i2=(std::size_t)(gen()%num_buckets),
+                  j=(std::size_t)(gen()%BucketSize);
+    std::uint64_t fp=gen()&(n%2?mask:3); /* many repeated fingerprints */
+
+    BOOST_TEST_EQ(buckets::find(array.data(),i,fp),model_find(i,fp));
+    BOOST_TEST_EQ(
+      buckets::contains(array.data(),i,i2,fp),
+      model_find(i,fp)!=BucketSize||model_find(i2,fp)!=BucketSize);
+    buckets::set(array.data(),i,j,fp);
+    model[i*BucketSize+j]=fp;
+    for(std::size_t k=0;k<num_buckets*BucketSize;++k){
+      BOOST_TEST_EQ(
+        buckets::get(array.data(),k/BucketSize,k%BucketSize),model[k]);
+    }
+  }
+  for(std::size_t k=0;k<buckets::tail_size;++k){
+    BOOST_TEST_EQ(array[buckets::used_array_size(num_buckets)+k],0);
+  }
+}
+
+int main()
+{
+  test_cuckoo_buckets<2,1>();
+  test_cuckoo_buckets<7,8>();
+  test_cuckoo_buckets<8,8>();
+  test_cuckoo_buckets<12,4>();
+  test_cuckoo_buckets<13,3>();
+  test_cuckoo_buckets<19,3>();
+  test_cuckoo_buckets<32,2>();
+
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
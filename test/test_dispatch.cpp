@@ -0,0 +1,184 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/detail/avx2.hpp>
+#include <boost/bloom/dispatched_fast_multiblock32.hpp>
+#include <boost/bloom/dispatched_fast_multiblock64.hpp>
+#include <boost/bloom/fast_multiblock32.hpp>
+#include <boost/bloom/fast_multiblock64.hpp>
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/multiblock.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <cstring>
+#include <vector>
+
+/* dispatched_fast_multiblock32/64 reproduce the bit mapping of the AVX2
+ * implementations of fast_multiblock32/64: for a given hash, the bit
+ * corresponding to lane i is calculated by reference_bit below. All
+ * implementations of fast_multiblock64 use this mapping as well.
+ */
+
+template<std::size_t LaneSize>
+std::size_t reference_bit(std::uint64_t hash,std::size_t i)
+{
+  const int     lane_bits=LaneSize==4?5:6;
+  std::uint64_t h=hash;
+  for(std::size_t j=0;j<i/8;++j)h=boost::bloom::detail::mulx64(h);
+  h<<=lane_bits*((i%8)/2);
+  if(i%2)h>>=32;
+  return LaneSize*8*i+(std::size_t)((std::uint32_t)h>>(32-lane_bits));
+}
+
+template<typename Subfilter,std::size_t LaneSize>
+void test_bit_mapping()
+{
+  using value_type=typename Subfilter::value_type;
+  static constexpr std::size_t k=Subfilter::k;
+
+  std::uint64_t hash=0x9E3779B97F4A7C15ull;
+  for(int i=0;i<100;++i){
+    hash=hash*6364136223846793005ull+1442695040888963407ull;
+
+    value_type x;
+    std::memset(&x,0,sizeof(x));
+    BOOST_TEST(Subfilter::try_mark(x,hash));
+    BOOST_TEST(!Subfilter::try_mark(x,hash));
+    BOOST_TEST(Subfilter::check(x,hash));
+
+    unsigned char expected[sizeof(value_type)]={0};
+    for(std::size_t j=0;j<k;++j){
+      std::size_t n=reference_bit<LaneSize>(hash,j);
+      expected[n/8]|=(unsigned char)(1u<<(n%8));
+    }
+    BOOST_TEST(std::memcmp(&x,expected,sizeof(x))==0);
+
+    value_type y;
+    std::memset(&y,0,sizeof(y));
+    Subfilter::mark(y,hash);
+    BOOST_TEST(std::memcmp(&x,&y,sizeof(x))==0);
+  }
+}
+
+/* Checks the kernels of every instruction set available, and not only
+ * those selected at run time, against reference_bit and against each
+ * other on random blocks.
+ */
+
+template<typename Kernels,std::size_t LaneSize,std::size_t K>
+void test_kernel_tables()
+{
+  using boost::bloom::detail::simd_level;
+
+  static constexpr std::size_t size=LaneSize*8*((K+7)/8);
+
+  int max_level=(int)boost::bloom::detail::runtime_simd_level();
+  auto portable=Kernels::table(simd_level::portable);
+  for(int level=0;level<=max_level;++level){
+    auto          t=Kernels::table((simd_level)level);
+    std::uint64_t hash=0x9E3779B97F4A7C15ull;
+    for(int i=0;i<100;++i){
+      hash=hash*6364136223846793005ull+1442695040888963407ull;
+
+      unsigned char x[size]={0};
+      BOOST_TEST(t.try_mark(x,hash));
+      BOOST_TEST(!t.try_mark(x,hash));
+      BOOST_TEST(t.check(x,hash));
+
+      unsigned char expected[size]={0};
+      for(std::size_t j=0;j<K;++j){
+        std::size_t n=reference_bit<LaneSize>(hash,j);
+        expected[n/8]|=(unsigned char)(1u<<(n%8));
+      }
+      BOOST_TEST(std::memcmp(x,expected,size)==0);
+
+      unsigned char y[size]={0};
+      t.mark(y,hash);
+      BOOST_TEST(std::memcmp(x,y,size)==0);
+
+      /* random blocks with varying density */
+
+      unsigned char z[size];
+      std::uint64_t r=hash;
+      for(std::size_t j=0;j<size;++j){
+        r=r*6364136223846793005ull+1442695040888963407ull;
+        z[j]=(unsigned char)(r>>56);
+        if(i%2)z[j]|=(unsigned char)(r>>48);
+      }
+      BOOST_TEST_EQ(t.check(z,hash),portable.check(z,hash));
+      unsigned char z1[size],z2[size];
+      std::memcpy(z1,z,size);
+      std::memcpy(z2,z,size);
+      BOOST_TEST_EQ(t.try_mark(z1,hash),portable.try_mark(z2,hash));
+      BOOST_TEST(std::memcmp(z1,z2,size)==0);
+    }
+  }
+}
+
+template<typename Filter1,typename Filter2>
+void test_same_array()
+{
+  std::vector<int> input;
+  for(int i=0;i<10000;++i)input.push_back(i);
+
+  Filter1 f1(100000);
+  Filter2 f2(f1.capacity());
+  BOOST_TEST_EQ(f1.capacity(),f2.capacity());
+  f1.insert(input.begin(),input.end());
+  f2.insert(input.begin(),input.end());
+  BOOST_TEST(
+    std::memcmp(f1.array().data(),f2.array().data(),f1.array().size())==0);
+  for(int i=0;i<20000;++i)BOOST_TEST_EQ(f1.may_contain(i),f2.may_contain(i));
+}
+
+template<std::size_t K>
+void test_dispatch()
+{
+  using namespace boost::bloom;
+
+  test_bit_mapping<dispatched_fast_multiblock32<K>,4>();
+  test_bit_mapping<dispatched_fast_multiblock64<K>,8>();
+  test_bit_mapping<fast_multiblock64<K>,8>();
+  test_kernel_tables<detail::fast_multiblock32_kernels<K>,4,K>();
+  test_kernel_tables<detail::fast_multiblock64_kernels<K>,8,K>();
+
+#if defined(BOOST_BLOOM_AVX2) /* AVX2 (or AVX-512) implementations in use */
+  test_same_array<
+    filter<int,1,fast_multiblock32<K>>,
+    filter<int,1,dispatched_fast_multiblock32<K>>>();
+  test_same_array<
+    filter<int,2,fast_multiblock32<K>,3>,
+    filter<int,2,dispatched_fast_multiblock32<K>,3>>();
+#endif
+
+  test_same_array<
+    filter<int,1,fast_multiblock64<K>>,
+    filter<int,1,dispatched_fast_multiblock64<K>>>();
+  test_same_array<
+    filter<int,1,fast_multiblock64<K>,5>,
+    filter<int,1,dispatched_fast_multiblock64<K>,5>>();
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    test_dispatch<T::value>();
+  }
+};
+
+int main()
+{
+  using namespace boost::mp11;
+
+  mp_for_each<mp_list_c<
+    std::size_t,1,2,3,4,5,7,8,9,12,15,16,17,24,25,31,32,33>>(lambda{});
+  return boost::report_errors();
+}
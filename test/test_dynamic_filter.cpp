@@ -0,0 +1,146 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/dynamic_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+/* dynamic_filter with k=K behaves exactly as filter<...,K,...> */
+
+template<typename Filter,typename ValueFactory>
+void test_equivalence()
+{
+  using filter=Filter;
+  using dynamic_filter=dynamic_filter_for<filter>;
+  using value_type=typename filter::value_type;
+
+  const std::size_t k=filter::k;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<10000;++i)input.push_back(fac());
+
+  for(std::size_t n:{0,1000,10000}){
+    for(double fpr:{0.1,0.01,0.0001}){
+      BOOST_TEST_EQ(
+        dynamic_filter::capacity_for(k,n,fpr),filter::capacity_for(n,fpr));
+      BOOST_TEST_EQ(
+        dynamic_filter(k,n,fpr).capacity(),filter(n,fpr).capacity());
+    }
+    for(std::size_t m:{0,1000,100000}){
+      BOOST_TEST_EQ(dynamic_filter::fpr_for(k,n,m),filter::fpr_for(n,m));
+    }
+  }
+
+  filter         f(20000);
+  dynamic_filter df(k,20000);
+  BOOST_TEST_EQ(df.k(),k);
+  BOOST_TEST_EQ(df.capacity(),f.capacity());
+
+  for(std::size_t i=0;i<input.size()/2;++i){
+    BOOST_TEST_EQ(df.try_insert(input[i]),f.try_insert(input[i]));
+  }
+  f.insert(input.begin()+input.size()/2,input.end()-100);
+  df.insert(input.begin()+input.size()/2,input.end()-100);
+  BOOST_TEST(same_array(f,df));
+
+  for(const auto& x:input)BOOST_TEST_EQ(df.may_contain(x),f.may_contain(x));
+  df.may_contain(input.begin(),input.end(),[&](const value_type& x,bool res){
+    BOOST_TEST_EQ(res,f.may_contain(x));
+  });
+  BOOST_TEST_EQ(df.estimated_size(),f.estimated_size());
+}
+
+template<typename Filter,typename ValueFactory>
+void test_dynamic_filter()
+{
+  using filter=Filter;
+  using dynamic_filter=dynamic_filter_for<filter>;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<1000;++i)input.push_back(fac());
+
+  {
+    dynamic_filter df;
+    BOOST_TEST_EQ(df.k(),1u);
+    BOOST_TEST_EQ(df.capacity(),0u);
+    BOOST_TEST_THROWS(dynamic_filter(0,1000),std::invalid_argument);
+    BOOST_TEST_THROWS(dynamic_filter(0,1000,0.01),std::invalid_argument);
+  }
+  {
+    dynamic_filter df1(3,10000),df2(5,10000);
+    df1.insert(input.begin(),input.end());
+    df2.insert(input.begin(),input.end());
+    BOOST_TEST_EQ(df1.capacity(),df2.capacity());
+    BOOST_TEST(df1!=df2);
+    BOOST_TEST_THROWS(df1&=df2,std::invalid_argument);
+    BOOST_TEST_THROWS(df1|=df2,std::invalid_argument);
+
+    dynamic_filter df3(df1);
+    BOOST_TEST_EQ(df3.k(),3u);
+    BOOST_TEST(df3==df1);
+    df3=df2;
+    BOOST_TEST_EQ(df3.k(),5u);
+    BOOST_TEST(df3==df2);
+    df3=std::move(df1);
+    BOOST_TEST_EQ(df3.k(),3u);
+    swap(df2,df3);
+    BOOST_TEST_EQ(df2.k(),3u);
+    BOOST_TEST_EQ(df3.k(),5u);
+    BOOST_TEST(may_contain(df2,input));
+    BOOST_TEST(may_contain(df3,input));
+
+    df2.reset(20000);
+    BOOST_TEST_EQ(df2.k(),3u);
+  }
+  {
+    /* fpr target met with different k (up to capacity rounding) */
+
+    for(std::size_t k=1;k<=12;++k){
+      dynamic_filter df(k,input.size(),0.01);
+      df.insert(input.begin(),input.end());
+      BOOST_TEST(may_contain(df,input));
+      BOOST_TEST_EQ(
+        df.capacity(),dynamic_filter::capacity_for(k,input.size(),0.01));
+      BOOST_TEST_LE(
+        dynamic_filter::fpr_for(k,input.size(),df.capacity()),0.0101);
+    }
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_equivalence<filter,value_factory<value_type>>();
+    test_equivalence< /* specialized code for run-time k */
+      rek_filter<filter,4>,value_factory<value_type>>();
+    test_equivalence< /* generic code for run-time k */
+      rek_filter<filter,11>,value_factory<value_type>>();
+    test_dynamic_filter<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,183 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/detail/array_ops.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "test_types.hpp"
+
+struct hash_factory /* splitmix64 */
+{
+  std::uint64_t operator()()
+  {
+    std::uint64_t z=(n+=0x9e3779b97f4a7c15ull);
+    z=(z^(z>>30))*0xbf58476d1ce4e5b9ull;
+    z=(z^(z>>27))*0x94d049bb133111ebull;
+    return z^(z>>31);
+  }
+
+  std::uint64_t n=0;
+};
+
+void test_count_ones()
+{
+  hash_factory               fac;
+  std::vector<unsigned char> v(1000);
+  for(auto& x:v)x=(unsigned char)fac();
+
+  auto naive_count=[](unsigned char x){
+    std::size_t res=0;
+    for(;x;x&=(unsigned char)(x-1))++res;
+    return res;
+  };
+
+  for(std::size_t first=0;first<8;++first){
+    for(std::size_t n=0;first+n<=v.size()/2;n+=(n<200?1:97)){
+      auto p=&v[first],q=&v[v.size()/2+first/2];
+
+      std::size_t expected_x=0,expected_y=0,expected_x_or_y=0;
+      for(std::size_t i=0;i<n;++i){
+        expected_x+=naive_count(p[i]);
+        expected_y+=naive_count(q[i]);
+        expected_x_or_y+=naive_count((unsigned char)(p[i]|q[i]));
+      }
+      BOOST_TEST_EQ(boost::bloom::detail::count_ones(p,n),expected_x);
+
+      auto c=boost::bloom::detail::count_ones(p,q,n);
+      BOOST_TEST_EQ(c.x,expected_x);
+      BOOST_TEST_EQ(c.y,expected_y);
+      BOOST_TEST_EQ(c.x_or_y,expected_x_or_y);
+    }
+  }
+}
+
+template<typename Filter>
+void test_estimation()
+{
+  using filter=Filter;
+
+  hash_factory fac;
+
+  {
+    filter f;
+    BOOST_TEST_EQ(f.estimated_size(),0u);
+    BOOST_TEST_EQ(f.estimated_fpr(),1.0);
+  }
+  for(std::size_t n:{1000,10000,100000}){
+    for(double fpr:{0.1,0.01,0.001}){
+      filter f(n,fpr);
+      BOOST_TEST_EQ(f.estimated_size(),0u);
+      BOOST_TEST_EQ(f.estimated_fpr(),0.0);
+
+      for(std::size_t m:{n/4,n}){
+        f.clear();
+        for(std::size_t i=0;i<m;++i)f.insert_hash(fac());
+        double err=(double)f.estimated_size()/m;
+        BOOST_TEST_GE(err,0.95);
+        BOOST_TEST_LE(err,1.05);
+        BOOST_TEST_EQ(
+          f.estimated_fpr(),filter::fpr_for(f.estimated_size(),f.capacity()));
+      }
+    }
+  }
+  {
+    filter f(1000,0.01);
+    std::memset(f.array().data(),0xFF,f.array().size());
+    BOOST_TEST_EQ(
+      f.estimated_size(),(std::numeric_limits<std::size_t>::max)());
+    BOOST_TEST_GT(f.estimated_fpr(),0.99);
+  }
+#if defined(BOOST_BLOOM_HAS_THREADS)
+  {
+    filter f(1u<<25);
+    for(std::size_t i=0;i<100000;++i)f.insert_hash(fac());
+    BOOST_TEST_EQ(f.parallel_estimated_size(),f.estimated_size());
+    BOOST_TEST_EQ(f.parallel_estimated_size(4),f.estimated_size());
+    BOOST_TEST_EQ(f.parallel_estimated_fpr(3),f.estimated_fpr());
+  }
+#endif
+}
+
+template<typename Filter>
+void test_set_estimation()
+{
+  using filter=Filter;
+
+  {
+    filter f1,f2;
+    BOOST_TEST_EQ(f1.estimated_union_size(f2),0u);
+    BOOST_TEST_EQ(f1.estimated_intersection_size(f2),0u);
+    BOOST_TEST_EQ(f1.estimated_jaccard_similarity(f2),0.0);
+  }
+  {
+    filter f1(1000,0.01),f2(10000,0.01);
+    BOOST_TEST_THROWS(
+      (void)f1.estimated_union_size(f2),std::invalid_argument);
+    BOOST_TEST_THROWS(
+      (void)f1.estimated_intersection_size(f2),std::invalid_argument);
+    BOOST_TEST_THROWS(
+      (void)f1.estimated_jaccard_similarity(f2),std::invalid_argument);
+  }
+  for(std::size_t n:{1000,10000,100000}){
+    for(std::size_t shared:{(std::size_t)0,n/10,n/2,n}){
+      hash_factory fac;
+      filter       f1(2*n,0.01),f2(2*n,0.01);
+      for(std::size_t i=0;i<shared;++i){
+        auto h=fac();
+        f1.insert_hash(h);
+        f2.insert_hash(h);
+      }
+      for(std::size_t i=shared;i<n;++i){
+        f1.insert_hash(fac());
+        f2.insert_hash(fac());
+      }
+
+      double union_size=(double)(2*n-shared);
+      double err=f1.estimated_union_size(f2)/union_size;
+      BOOST_TEST_GE(err,0.95);
+      BOOST_TEST_LE(err,1.05);
+      BOOST_TEST_EQ(
+        f1.estimated_union_size(f2),(filter(f1)|=f2).estimated_size());
+
+      double diff=
+        (double)f1.estimated_intersection_size(f2)-(double)shared;
+      BOOST_TEST_LE(std::abs(diff),0.05*union_size);
+      BOOST_TEST_EQ(
+        f1.estimated_intersection_size(f2),
+        f2.estimated_intersection_size(f1));
+
+      BOOST_TEST_LE(
+        std::abs(
+          f1.estimated_jaccard_similarity(f2)-(double)shared/union_size),
+        0.05);
+    }
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    test_estimation<typename T::type>();
+    test_set_estimation<typename T::type>();
+  }
+};
+
+int main()
+{
+  test_count_ones();
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
@@ -0,0 +1,110 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/block.hpp>
+#include <boost/bloom/detail/mulx64.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/* block<Block[N],K> may use SIMD code when available: check that bits are
+ * set as described in the reference, i.e. for each of the K bit positions
+ * n consecutively extracted from the hash value, bit n/N of x[n%N].
+ */
+
+template<typename Block,std::size_t N,std::size_t K>
+void reference_mark(Block (&x)[N],std::uint64_t hash)
+{
+  std::size_t width=sizeof(Block)*N*CHAR_BIT,shift=0;
+  while(((std::size_t)1<<shift)<width)++shift;
+  std::size_t rehash_k=(64-shift)/shift;
+
+  std::uint64_t h=hash;
+  for(std::size_t i=0;i<K;++i){
+    if(i&&i%rehash_k==0){
+      hash=boost::bloom::detail::mulx64(hash);
+      h=hash;
+    }
+    h>>=shift;
+    std::size_t n=(std::size_t)(h&(width-1));
+    x[n%N]|=Block(1)<<(n/N);
+  }
+}
+
+template<typename Block,std::size_t N,std::size_t K>
+void test_extended_block()
+{
+  using subfilter=boost::bloom::block<Block[N],K>;
+  using value_type=Block[N];
+
+  std::uint64_t hash=0x9E3779B97F4A7C15ull;
+  value_type    acc;
+  std::memset(&acc,0,sizeof(acc));
+  for(int i=0;i<200;++i){
+    hash=hash*6364136223846793005ull+1442695040888963407ull;
+
+    value_type x,y;
+    std::memset(&x,0,sizeof(x));
+    std::memset(&y,0,sizeof(y));
+    subfilter::mark(x,hash);
+    reference_mark<Block,N,K>(y,hash);
+    BOOST_TEST(std::memcmp(&x,&y,sizeof(x))==0);
+    BOOST_TEST(subfilter::check(x,hash));
+
+    std::memset(&x,0,sizeof(x));
+    BOOST_TEST(subfilter::try_mark(x,hash));
+    BOOST_TEST(!subfilter::try_mark(x,hash));
+    BOOST_TEST(std::memcmp(&x,&y,sizeof(x))==0);
+
+    /* check against a block with all bits but one of the fingerprint */
+    for(std::size_t j=0;j<N;++j){
+      if(y[j]){
+        Block b=y[j]&(Block)(~y[j]+1); /* lowest bit set */
+        std::memcpy(&x,&acc,sizeof(x));
+        for(std::size_t l=0;l<N;++l)x[l]|=y[l];
+        x[j]&=(Block)~b;
+        BOOST_TEST_EQ(subfilter::check(x,hash),false);
+        BOOST_TEST_EQ(subfilter::try_mark(x,hash),true);
+        BOOST_TEST(subfilter::check(x,hash));
+        break;
+      }
+    }
+
+    for(std::size_t l=0;l<N;++l)acc[l]|=y[l];
+    BOOST_TEST(subfilter::check(acc,hash));
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    static constexpr std::size_t K=T::value;
+
+    test_extended_block<std::uint64_t,8,K>();
+    test_extended_block<std::uint64_t,4,K>();
+    test_extended_block<std::uint32_t,16,K>();
+    test_extended_block<std::uint32_t,8,K>();
+    test_extended_block<unsigned long long,8,K>();
+    test_extended_block<std::uint16_t,16,K>();
+    test_extended_block<std::uint64_t,2,K>();
+  }
+};
+
+int main()
+{
+  using namespace boost::mp11;
+
+  mp_for_each<mp_list_c<std::size_t,1,2,3,5,6,7,8,13,16>>(lambda{});
+  return boost::report_errors();
+}
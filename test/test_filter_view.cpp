@@ -0,0 +1,169 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/filter_view.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+/* external memory, cacheline-aligned and padded past the end as
+ * fast_multiblock subfilters may read beyond used_value_size
+ */
+
+struct external_array
+{
+  external_array(boost::span<const unsigned char> x):buf(x.size()+128)
+  {
+    auto p=buf.data();
+    p+=(64-(std::uintptr_t)p%64)%64;
+    if(x.size())std::memcpy(p,x.data(),x.size());
+    data=boost::span<const unsigned char>{p,x.size()};
+  }
+
+  std::vector<unsigned char>       buf;
+  boost::span<const unsigned char> data;
+};
+
+template<typename Filter,typename ValueFactory>
+void test_filter_view()
+{
+  using filter=Filter;
+  using filter_view=filter_view_for<filter>;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<1000;++i)input.push_back(fac());
+  std::vector<value_type> lookup_input=input;
+  for(int i=0;i<1000;++i)lookup_input.push_back(fac());
+
+  {
+    filter_view fv;
+    BOOST_TEST_EQ(fv.capacity(),0u);
+    BOOST_TEST_EQ(fv.array().size(),0u);
+    BOOST_TEST(may_contain(fv,lookup_input));
+    filter_view fv2{boost::span<const unsigned char>{}};
+    BOOST_TEST_EQ(fv2.capacity(),0u);
+    BOOST_TEST(fv==fv2);
+  }
+
+  filter f(10000);
+  f.insert(input.begin(),input.end());
+  external_array ea(f.array());
+  filter_view    fv(ea.data);
+  BOOST_TEST_EQ(fv.capacity(),f.capacity());
+  BOOST_TEST_EQ(fv.array().data(),ea.data.data());
+  BOOST_TEST_EQ(fv.array().size(),ea.data.size());
+  BOOST_TEST_EQ(fv.estimated_size(),f.estimated_size());
+  BOOST_TEST_EQ(fv.estimated_fpr(),f.estimated_fpr());
+  BOOST_TEST(may_contain(fv,input));
+
+  for(const auto& x:lookup_input){
+    BOOST_TEST_EQ(fv.may_contain(x),f.may_contain(x));
+    BOOST_TEST_EQ(fv.may_contain_hash(fv.hash_for(x)),f.may_contain(x));
+  }
+  std::size_t n=0;
+  fv.may_contain(
+    lookup_input.begin(),lookup_input.end(),
+    [&](const value_type& x,bool res){
+      BOOST_TEST_EQ(res,f.may_contain(x));
+      ++n;
+    });
+  BOOST_TEST_EQ(n,lookup_input.size());
+  {
+    std::vector<std::uint64_t> bitmap1((lookup_input.size()+63)/64),
+                               bitmap2(bitmap1.size());
+    BOOST_TEST_EQ(
+      fv.may_contain_bitmap(lookup_input,bitmap1.data()),
+      f.may_contain_bitmap(lookup_input,bitmap2.data()));
+    BOOST_TEST(bitmap1==bitmap2);
+  }
+
+  /* view over a filter's own array */
+
+  {
+    filter_view fv2(f);
+    BOOST_TEST_EQ(fv2.array().data(),f.array().data());
+    BOOST_TEST(fv2==fv);
+    f.clear();
+    BOOST_TEST(fv2!=fv);
+    BOOST_TEST(!may_contain(fv2,input));
+  }
+
+  /* copy, move, assignment and swap don't touch the array */
+
+  {
+    filter_view fv2(fv);
+    BOOST_TEST_EQ(fv2.array().data(),fv.array().data());
+    filter_view fv3(std::move(fv2));
+    BOOST_TEST_EQ(fv3.array().data(),fv.array().data());
+    BOOST_TEST_EQ(fv2.capacity(),0u);
+    fv2=fv3;
+    BOOST_TEST_EQ(fv2.array().data(),fv.array().data());
+    fv3=filter_view{};
+    BOOST_TEST_EQ(fv3.capacity(),0u);
+    swap(fv2,fv3);
+    BOOST_TEST_EQ(fv2.capacity(),0u);
+    BOOST_TEST_EQ(fv3.array().data(),fv.array().data());
+    fv3=std::move(fv2);
+    BOOST_TEST_EQ(fv3.capacity(),0u);
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_filter_view<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+
+  /* invalid arrays */
+
+  {
+    using filter=boost::bloom::filter<
+      int,1,boost::bloom::block<std::uint64_t,5>>;
+    using filter_view=filter_view_for<filter>;
+
+    filter         f(1000);
+    external_array ea(f.array());
+    auto           p=ea.data.data();
+    auto           s=ea.data.size();
+
+    BOOST_TEST_THROWS(
+      filter_view(boost::span<const unsigned char>(p,s-1)),
+      std::invalid_argument);
+    BOOST_TEST_THROWS(
+      filter_view(boost::span<const unsigned char>(p,4)),
+      std::invalid_argument);
+    BOOST_TEST_THROWS( /* misaligned blocks */
+      filter_view(boost::span<const unsigned char>(p+1,s-8)),
+      std::invalid_argument);
+    BOOST_TEST_EQ(
+      filter_view(boost::span<const unsigned char>(p,s-8)).capacity(),
+      f.capacity()-64);
+  }
+
+  return boost::report_errors();
+}
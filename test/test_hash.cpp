@@ -0,0 +1,115 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cstdint>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_hash()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory fac;
+
+  {
+    std::vector<value_type>    input;
+    std::vector<std::uint64_t> hashes;
+    filter                     f1(1000);
+    for(std::size_t i=0;i<1000;++i){
+      input.push_back(fac());
+      hashes.push_back(f1.hash_for(input.back()));
+    }
+
+    /* hashes are independent of the filter's capacity */
+
+    filter f2(f1.capacity()),f3(f1.capacity()),f4(100000),f5(f4.capacity());
+    f1.insert(input.begin(),input.begin()+500);
+    for(std::size_t i=0;i<500;++i)f2.insert_hash(hashes[i]);
+    f3.insert_hash(hashes.begin(),hashes.begin()+500);
+    f4.insert(input.begin(),input.begin()+500);
+    f5.insert_hash(
+      make_input_iterator(hashes.begin()),
+      make_input_iterator(hashes.begin()+500));
+    BOOST_TEST(f1==f2);
+    BOOST_TEST(f1==f3);
+    BOOST_TEST(f4==f5);
+
+    std::vector<bool>          expected;
+    std::vector<std::uint64_t> expected_bitmap(hashes.size()/64+1,0);
+    std::vector<std::uint32_t> expected_selection;
+    for(std::size_t i=0;i<input.size();++i){
+      bool res=f1.may_contain(input[i]);
+      BOOST_TEST_EQ(f1.may_contain_hash(hashes[i]),res);
+      expected.push_back(res);
+      if(res){
+        expected_bitmap[i/64]|=std::uint64_t(1)<<(i%64);
+        expected_selection.push_back((std::uint32_t)i);
+      }
+    }
+
+    std::vector<std::uint64_t> visited;
+    std::vector<bool>          results;
+    auto                       record=[&](std::uint64_t hash,bool res){
+      visited.push_back(hash);
+      results.push_back(res);
+    };
+
+    f1.may_contain_hash(hashes.begin(),hashes.end(),record);
+    BOOST_TEST(visited==hashes);
+    BOOST_TEST(results==expected);
+
+    visited.clear();
+    results.clear();
+    f1.may_contain_hash(
+      make_input_iterator(hashes.begin()),make_input_iterator(hashes.end()),
+      record);
+    BOOST_TEST(visited==hashes);
+    BOOST_TEST(results==expected);
+
+    std::vector<std::uint64_t> bitmap(expected_bitmap.size());
+    BOOST_TEST_EQ(
+      f1.may_contain_hash_bitmap(hashes,bitmap.data()),
+      expected_selection.size());
+    BOOST_TEST(bitmap==expected_bitmap);
+
+    std::vector<std::uint32_t> selection(hashes.size());
+    selection.resize(f1.may_contain_hash_selection(hashes,selection.data()));
+    BOOST_TEST(selection==expected_selection);
+  }
+  {
+    filter f;
+    f.insert_hash(f.hash_for(fac()));
+    BOOST_TEST(f==filter{});
+    BOOST_TEST(f.may_contain_hash(f.hash_for(fac())));
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_hash<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
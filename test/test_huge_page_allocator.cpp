@@ -0,0 +1,101 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/filter.hpp>
+#include <boost/bloom/huge_page_allocator.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_huge_page_allocator()
+{
+  using filter=Filter;
+  using huge_page_filter=
+    realloc_filter<filter,boost::bloom::huge_page_allocator<>>;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<1000;++i)input.push_back(fac());
+
+  /* below and above the huge page threshold */
+
+  for(std::size_t m:{0,10000,50000000}){
+    filter           f(m);
+    huge_page_filter hf(m);
+    BOOST_TEST_EQ(hf.capacity(),f.capacity());
+    f.insert(input.begin(),input.end());
+    hf.insert(input.begin(),input.end());
+    BOOST_TEST(may_contain(hf,input));
+#if defined(BOOST_BLOOM_HAS_HUGE_PAGES)
+    if(hf.array().size()>=(1<<21)){ /* array starts at a page boundary */
+      BOOST_TEST_EQ(std::uintptr_t(hf.array().data())%(1<<21),0u);
+    }
+#endif
+    BOOST_TEST(same_array(hf,f));
+
+    huge_page_filter hf2(hf);
+    BOOST_TEST(hf2==hf);
+    huge_page_filter hf3(std::move(hf2));
+    BOOST_TEST(hf3==hf);
+    hf2=hf3;
+    BOOST_TEST(hf2==hf);
+    hf3.reset(m/2);
+    hf3.clear();
+    hf3|=huge_page_filter(m/2);
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_huge_page_allocator<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  using allocator=boost::bloom::huge_page_allocator<>;
+
+  BOOST_TEST(allocator()==boost::bloom::huge_page_allocator<int>());
+  BOOST_TEST(!(allocator()!=boost::bloom::huge_page_allocator<int>()));
+
+  for(std::size_t n:{1,4096,(1<<21)-1,1<<21,(1<<21)+1,10000000}){
+    allocator al;
+    auto      p=al.allocate(n);
+    std::memset(p,0xAA,n);
+    BOOST_TEST_EQ(p[n-1],0xAA);
+#if defined(BOOST_BLOOM_HAS_HUGE_PAGES)
+    if(n>=(1<<21))BOOST_TEST_EQ(std::uintptr_t(p)%(1<<21),0u);
+#endif
+    al.deallocate(p,n);
+  }
+  {
+    boost::bloom::huge_page_allocator<std::uint64_t> al;
+    std::size_t                                      n=(1<<21)/8+1;
+    auto                                             p=al.allocate(n);
+    p[n-1]=1;
+    al.deallocate(p,n);
+  }
+
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
@@ -9,7 +9,9 @@
 #include <boost/core/lightweight_test.hpp>
 #include <array>
 #include <boost/mp11/algorithm.hpp>
+#include <cstdint>
 #include <utility>
+#include <vector>
 #include "test_types.hpp"
 #include "test_utilities.hpp"
 
@@ -65,6 +67,12 @@ void test_insertion()
     f.insert(x); /* transparent insert */
     BOOST_TEST(f.may_contain(x));
   }
+  {
+    auto x=fac();
+    BOOST_TEST(f.try_insert(x)); /* transparent try_insert */
+    BOOST_TEST(f.may_contain(x));
+    BOOST_TEST(!f.try_insert(x));
+  }
   {
     std::array<value_type,10> input;
     for(auto& x:input)x={fac(),0};
@@ -78,6 +86,159 @@ void test_insertion()
   }
 }
 
+template<typename Filter,typename ValueFactory>
+void test_try_insertion()
+{
+  using filter=Filter;
+
+  ValueFactory fac;
+
+  /* small capacities produce plenty of false positives */
+
+  for(std::size_t m:{(std::size_t)100,(std::size_t)1000,(std::size_t)10000}){
+    filter      f1(m),f2(m);
+    std::size_t num_inserted=0;
+    for(int i=0;i<1000;++i){
+      auto x=fac();
+      bool expected=!f1.may_contain(x);
+      bool res=f1.try_insert(x);
+      BOOST_TEST_EQ(res,expected);
+      BOOST_TEST(f1.may_contain(x));
+      BOOST_TEST(!f1.try_insert(x));
+      f2.insert(x);
+      num_inserted+=res;
+    }
+    BOOST_TEST(f1==f2);
+    BOOST_TEST_GT(num_inserted,0u);
+  }
+  {
+    filter f;
+    BOOST_TEST(!f.try_insert(fac()));
+    BOOST_TEST(f==filter{});
+  }
+}
+
+template<typename Filter,typename ValueFactory>
+void test_bulk_insertion()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory fac;
+
+  for(std::size_t n:{
+    (std::size_t)0,(std::size_t)1,
+    filter::bulk_insert_size-1,filter::bulk_insert_size,
+    filter::bulk_insert_size+1,2*filter::bulk_insert_size,
+    (std::size_t)1000}){
+    std::vector<value_type> input;
+    for(std::size_t i=0;i<n;++i)input.push_back(fac());
+
+    filter f1(10000),f2(f1.capacity()),f3(f1.capacity());
+    f1.insert(input.begin(),input.end());
+    for(const auto& x:input)f2.insert(x);
+    f3.insert(
+      make_input_iterator(input.begin()),make_input_iterator(input.end()));
+    BOOST_TEST(f1==f2);
+    BOOST_TEST(f1==f3);
+    BOOST_TEST(may_contain(f1,input));
+  }
+  {
+    std::vector<value_type> input;
+    for(std::size_t i=0;i<1000;++i)input.push_back(fac());
+
+    filter f;
+    f.insert(input.begin(),input.end());
+    BOOST_TEST(f==filter{});
+  }
+}
+
+template<typename Filter,typename ValueFactory>
+void test_bulk_lookup()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory fac;
+
+  for(std::size_t n:{
+    (std::size_t)0,(std::size_t)1,
+    filter::bulk_may_contain_size-1,filter::bulk_may_contain_size,
+    filter::bulk_may_contain_size+1,2*filter::bulk_may_contain_size,
+    (std::size_t)1000}){
+    std::vector<value_type> input;
+    for(std::size_t i=0;i<n;++i)input.push_back(fac());
+
+    filter f(input.begin(),input.begin()+n/2,1000);
+    std::vector<bool> expected;
+    for(const auto& x:input)expected.push_back(f.may_contain(x));
+
+    std::vector<value_type> visited;
+    std::vector<bool>       results;
+    auto                    record=[&](const value_type& x,bool res){
+      visited.push_back(x);
+      results.push_back(res);
+    };
+
+    f.may_contain(input.begin(),input.end(),record);
+    BOOST_TEST(visited==input);
+    BOOST_TEST(results==expected);
+
+    visited.clear();
+    results.clear();
+    f.may_contain(
+      make_input_iterator(input.begin()),make_input_iterator(input.end()),
+      record);
+    BOOST_TEST(visited==input);
+    BOOST_TEST(results==expected);
+  }
+  {
+    std::vector<value_type> input;
+    for(std::size_t i=0;i<100;++i)input.push_back(fac());
+
+    const filter f;
+    std::size_t  res=0;
+    f.may_contain(
+      input.begin(),input.end(),[&](const value_type&,bool b){res+=b;});
+    BOOST_TEST_EQ(res,input.size());
+  }
+}
+
+template<typename Filter,typename ValueFactory>
+void test_bitmap_selection_lookup()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory fac;
+
+  for(std::size_t n:{
+    (std::size_t)0,(std::size_t)1,(std::size_t)63,(std::size_t)64,
+    (std::size_t)65,filter::bulk_may_contain_size+1,(std::size_t)1000}){
+    std::vector<value_type> input;
+    for(std::size_t i=0;i<n;++i)input.push_back(fac());
+
+    filter                     f(input.begin(),input.begin()+n/2,1000);
+    std::vector<std::uint64_t> expected_bitmap((n+63)/64,0);
+    std::vector<std::uint32_t> expected_selection;
+    for(std::size_t i=0;i<n;++i){
+      if(f.may_contain(input[i])){
+        expected_bitmap[i/64]|=std::uint64_t(1)<<(i%64);
+        expected_selection.push_back((std::uint32_t)i);
+      }
+    }
+
+    std::vector<std::uint64_t> bitmap((n+63)/64,~std::uint64_t(0));
+    BOOST_TEST_EQ(
+      f.may_contain_bitmap(input,bitmap.data()),expected_selection.size());
+    BOOST_TEST(bitmap==expected_bitmap);
+
+    std::vector<std::uint32_t> selection(n);
+    selection.resize(f.may_contain_selection(input,selection.data()));
+    BOOST_TEST(selection==expected_selection);
+  }
+}
+
 struct lambda
 {
   template<typename T>
@@ -87,6 +248,10 @@ struct lambda
     using value_type=typename filter::value_type;
 
     test_insertion<filter,value_factory<value_type>>();
+    test_try_insertion<filter,value_factory<value_type>>();
+    test_bulk_insertion<filter,value_factory<value_type>>();
+    test_bulk_lookup<filter,value_factory<value_type>>();
+    test_bitmap_selection_lookup<filter,value_factory<value_type>>();
   }
 };
 
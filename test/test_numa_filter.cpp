@@ -0,0 +1,178 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/numa_filter.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename Filter,typename ValueFactory>
+void test_numa_filter()
+{
+  using filter=Filter;
+  using numa_filter=retemplate_filter<filter,boost::bloom::numa_filter>;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<1000;++i)input.push_back(fac());
+  std::vector<value_type> lookup_input=input;
+  for(int i=0;i<1000;++i)lookup_input.push_back(fac());
+
+  {
+    numa_filter nf;
+    BOOST_TEST_GE(nf.num_replicas(),1u);
+    BOOST_TEST_EQ(nf.capacity(),0u);
+    BOOST_TEST(may_contain(nf,lookup_input));
+  }
+
+  filter      f(10000);
+  numa_filter nf(10000);
+  BOOST_TEST_EQ(nf.capacity(),f.capacity());
+  f.insert(input.begin(),input.end());
+  nf.insert(input.begin(),input.begin()+500);
+  for(auto it=input.begin()+500;it!=input.end();++it)nf.insert(*it);
+  BOOST_TEST(may_contain(nf,input));
+  for(std::size_t i=0;i<nf.num_replicas();++i)BOOST_TEST(nf.replica(i)==f);
+  BOOST_TEST(nf.local_replica()==f);
+  BOOST_TEST_EQ(nf.estimated_size(),f.estimated_size());
+  for(const auto& x:lookup_input){
+    BOOST_TEST_EQ(nf.may_contain(x),f.may_contain(x));
+    BOOST_TEST_EQ(nf.may_contain_hash(nf.hash_for(x)),f.may_contain(x));
+  }
+  {
+    std::vector<std::uint64_t> bitmap1((lookup_input.size()+63)/64),
+                               bitmap2(bitmap1.size());
+    BOOST_TEST_EQ(
+      nf.may_contain_bitmap(lookup_input,bitmap1.data()),
+      f.may_contain_bitmap(lookup_input,bitmap2.data()));
+    BOOST_TEST(bitmap1==bitmap2);
+  }
+  {
+    /* more hashes than a chunk */
+
+    std::vector<std::uint64_t> hashes;
+    for(const auto& x:lookup_input)hashes.push_back(nf.hash_for(x));
+    filter      f2(10000);
+    numa_filter nf2(10000);
+    f2.insert(lookup_input.begin(),lookup_input.end());
+    nf2.insert_hash(hashes.begin(),hashes.end());
+    for(std::size_t i=0;i<nf2.num_replicas();++i){
+      BOOST_TEST(nf2.replica(i)==f2);
+    }
+  }
+
+  /* replication of an existing filter and propagation with |= */
+
+  {
+    numa_filter nf2(f);
+    BOOST_TEST(nf2==nf);
+    filter staging(f.capacity());
+    staging.insert(lookup_input.begin(),lookup_input.end());
+    nf2|=staging;
+    f|=staging;
+    for(std::size_t i=0;i<nf2.num_replicas();++i){
+      BOOST_TEST(nf2.replica(i)==f);
+    }
+    BOOST_TEST(may_contain(nf2,lookup_input));
+    BOOST_TEST_THROWS(nf2|=filter(f.capacity()*2),std::invalid_argument);
+    nf2&=filter(f.capacity());
+    BOOST_TEST(nf2==numa_filter(f.capacity()));
+  }
+
+  /* copy, move, assignment, clear and reset */
+
+  {
+    numa_filter nf2(nf);
+    BOOST_TEST(nf2==nf);
+    numa_filter nf3(std::move(nf2));
+    BOOST_TEST(nf3==nf);
+    BOOST_TEST_EQ(nf2.capacity(),0u);
+    BOOST_TEST_EQ(nf2.num_replicas(),nf.num_replicas());
+    nf2=nf3;
+    BOOST_TEST(nf2==nf);
+    nf3=numa_filter{};
+    BOOST_TEST_EQ(nf3.capacity(),0u);
+    swap(nf2,nf3);
+    BOOST_TEST(nf3==nf);
+    BOOST_TEST(nf2!=nf);
+    nf3.clear();
+    BOOST_TEST(nf3==numa_filter(nf.capacity()));
+    nf3.reset(nf.capacity()*2);
+    BOOST_TEST_GE(nf3.capacity(),nf.capacity()*2);
+    for(std::size_t i=0;i<nf3.num_replicas();++i){
+      BOOST_TEST_EQ(nf3.replica(i).capacity(),nf3.capacity());
+    }
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_numa_filter<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  using boost::bloom::detail::parse_cpu_list;
+
+  {
+    std::vector<unsigned> v;
+    BOOST_TEST(parse_cpu_list("0-3,8,10-11\n",v));
+    BOOST_TEST((v==std::vector<unsigned>{0,1,2,3,8,10,11}));
+    BOOST_TEST(parse_cpu_list("",v));
+    BOOST_TEST(v.empty());
+    BOOST_TEST(parse_cpu_list("5",v));
+    BOOST_TEST((v==std::vector<unsigned>{5}));
+    BOOST_TEST(!parse_cpu_list("3-1",v));
+    BOOST_TEST(!parse_cpu_list("1,,2",v));
+    BOOST_TEST(!parse_cpu_list("1;2",v));
+    BOOST_TEST(!parse_cpu_list("x",v));
+  }
+  {
+    const auto& topology=boost::bloom::detail::get_numa_topology();
+    BOOST_TEST_GE(topology.nodes.size(),1u);
+    BOOST_TEST_LT(topology.current_node_index(),topology.nodes.size());
+  }
+  {
+    /* multiple (simulated) nodes */
+
+    std::vector<boost::bloom::detail::numa_node> nodes(3);
+    std::vector<int>                             res(3,0);
+    boost::bloom::detail::run_on_numa_nodes(nodes,[&](std::size_t i){
+      res[i]=(int)i+1;
+    });
+    BOOST_TEST((res==std::vector<int>{1,2,3}));
+
+    std::atomic<int> n{0};
+    BOOST_TEST_THROWS(
+      boost::bloom::detail::run_on_numa_nodes(nodes,[&](std::size_t i){
+        ++n;
+        if(i==1)throw std::runtime_error("");
+      }),
+      std::runtime_error);
+    BOOST_TEST_EQ(n.load(),3);
+  }
+
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
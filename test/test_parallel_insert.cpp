@@ -0,0 +1,106 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/filter.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+template<typename T>
+struct throwing_hash
+{
+  std::size_t operator()(const T& x)const
+  {
+    if(*armed&&x==bad)throw std::runtime_error("");
+    return boost::hash<T>{}(x);
+  }
+
+  T           bad;
+  const bool* armed;
+};
+
+template<typename Filter,typename ValueFactory>
+void test_parallel_insert()
+{
+  using filter=Filter;
+  using value_type=typename filter::value_type;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<100000;++i)input.push_back(fac());
+
+  {
+    filter f;
+    f.parallel_insert(input);
+    BOOST_TEST(f==filter{});
+  }
+
+  /* small capacities so that blocks straddle partition boundaries */
+
+  for(std::size_t m:{(std::size_t)100,(std::size_t)10000,(std::size_t)1000000}){
+    for(std::size_t n:{
+      (std::size_t)0,(std::size_t)1,(std::size_t)8192*3+5,input.size()}){
+      filter f1(m);
+      f1.insert(input.begin(),input.begin()+n);
+
+      std::vector<std::uint64_t> hashes;
+      for(std::size_t i=0;i<n;++i)hashes.push_back(f1.hash_for(input[i]));
+
+      for(std::size_t num_threads:{
+        (std::size_t)0,(std::size_t)1,(std::size_t)2,
+        (std::size_t)3,(std::size_t)8}){
+        filter f2(m);
+        f2.parallel_insert({input.data(),n},num_threads);
+        BOOST_TEST(f1==f2);
+
+        filter f3(m);
+        f3.parallel_insert_hash(hashes,num_threads);
+        BOOST_TEST(f1==f3);
+      }
+    }
+  }
+
+  /* exceptions thrown by the hash function propagate to the caller */
+
+  {
+    using throwing_filter=rehash_filter<filter,throwing_hash<value_type>>;
+
+    bool            armed=true;
+    throwing_filter f(10000,throwing_hash<value_type>{input[50000],&armed});
+    BOOST_TEST_THROWS(f.parallel_insert(input,4),std::runtime_error);
+    BOOST_TEST_THROWS(f.parallel_insert(input,1),std::runtime_error);
+    armed=false;
+    f.parallel_insert(input,4);
+    BOOST_TEST(may_contain(f,input));
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_parallel_insert<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+  return boost::report_errors();
+}
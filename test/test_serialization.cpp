@@ -0,0 +1,278 @@
+/* Copyright 2025 Joaquin M Lopez Munoz.
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * See https://www.boost.org/libs/bloom for library home page.
+ */
+
+#include <boost/bloom/serialization.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "test_types.hpp"
+#include "test_utilities.hpp"
+
+using namespace test_utilities;
+
+/* serialized data copied to cacheline-aligned memory as if mmapped */
+
+struct aligned_buffer
+{
+  aligned_buffer(const std::string& str):buf(str.size()+64)
+  {
+    auto p=buf.data();
+    p+=(64-(std::uintptr_t)p%64)%64;
+    std::memcpy(p,str.data(),str.size());
+    data=boost::span<const unsigned char>{p,str.size()};
+  }
+
+  std::vector<unsigned char>       buf;
+  boost::span<const unsigned char> data;
+};
+
+template<typename Filter>
+std::string save_to_string(const Filter& f,std::uint64_t hash_id=0)
+{
+  std::ostringstream out;
+  boost::bloom::save(f,out,hash_id);
+  return out.str();
+}
+
+template<typename Filter>
+void load_from_string(
+  Filter& f,const std::string& str,std::uint64_t hash_id=0)
+{
+  std::istringstream in(str);
+  boost::bloom::load(f,in,hash_id);
+}
+
+template<typename Filter,typename ValueFactory>
+void test_serialization()
+{
+  using filter=Filter;
+  using filter_view=filter_view_for<filter>;
+  using dynamic_filter=dynamic_filter_for<filter>;
+  using value_type=typename filter::value_type;
+
+  const std::size_t k=filter::k;
+
+  ValueFactory            fac;
+  std::vector<value_type> input;
+  for(int i=0;i<1000;++i)input.push_back(fac());
+
+  for(std::size_t m:{0,10000}){
+    filter f(m);
+    f.insert(input.begin(),input.end());
+    auto str=save_to_string(f);
+    BOOST_TEST_EQ(str.size(),128+f.array().size());
+
+    filter f2(100);
+    load_from_string(f2,str);
+    BOOST_TEST(f2==f);
+
+    aligned_buffer buf(str);
+    auto           fv=boost::bloom::load_view<filter_view>(buf.data,0);
+    BOOST_TEST_EQ(fv.capacity(),f.capacity());
+    if(m)BOOST_TEST_EQ(fv.array().data(),buf.data.data()+64);
+    BOOST_TEST(fv==filter_view(f));
+  }
+
+  filter f(10000);
+  f.insert(input.begin(),input.end());
+
+  /* compressed encodings at different fill levels */
+
+  for(std::size_t num_elements:{0,10,100,1000}){
+    filter f1(100000);
+    f1.insert(input.begin(),input.begin()+num_elements);
+    std::ostringstream out;
+    boost::bloom::save_compressed(f1,out,0);
+    auto str=out.str();
+    BOOST_TEST_LE(str.size(),save_to_string(f1).size());
+
+    filter f2(100);
+    load_from_string(f2,str);
+    BOOST_TEST(f2==f1);
+
+    if(str.size()<save_to_string(f1).size()){
+      aligned_buffer buf(str);
+      BOOST_TEST_THROWS(
+        boost::bloom::load_view<filter_view>(buf.data,0),std::runtime_error);
+      str[str.size()-65]^=1; /* last byte of payload */
+      BOOST_TEST_THROWS(load_from_string(f2,str),std::runtime_error);
+      BOOST_TEST_EQ(f2.capacity(),0u);
+    }
+  }
+
+  /* dynamic_filter takes k from the data */
+
+  {
+    dynamic_filter df(k,10000);
+    df.insert(input.begin(),input.end());
+    auto str=save_to_string(df);
+    BOOST_TEST(str==save_to_string(f));
+
+    dynamic_filter df2(k+1,1000);
+    load_from_string(df2,str);
+    BOOST_TEST_EQ(df2.k(),k);
+    BOOST_TEST(df2==df);
+
+    filter f2;
+    load_from_string(f2,str);
+    BOOST_TEST(f2==f);
+  }
+
+  /* mismatches and corruption */
+
+  {
+    auto str=save_to_string(f,42);
+    filter f2;
+    BOOST_TEST_THROWS(load_from_string(f2,str),std::runtime_error);
+    BOOST_TEST_THROWS(load_from_string(f2,str,43),std::runtime_error);
+    load_from_string(f2,str,42);
+    BOOST_TEST(f2==f);
+
+    aligned_buffer buf(str);
+    BOOST_TEST_THROWS(
+      boost::bloom::load_view<filter_view>(buf.data,0),std::runtime_error);
+    BOOST_TEST_THROWS(
+      boost::bloom::load_view<filter_view>(buf.data.first(100),42),
+      std::runtime_error);
+    BOOST_TEST(
+      boost::bloom::load_view<filter_view>(buf.data,42)==filter_view(f));
+
+    dynamic_filter df(k+1,10000);
+    auto str2=save_to_string(df);
+    BOOST_TEST_THROWS(load_from_string(f2,str2),std::runtime_error);
+
+    std::string str3=save_to_string(f);
+    str3[70]^=1; /* array */
+    BOOST_TEST_THROWS(load_from_string(f2,str3),std::runtime_error);
+    BOOST_TEST_EQ(f2.capacity(),0u);
+    aligned_buffer buf3(str3);
+    BOOST_TEST_THROWS(
+      boost::bloom::load_view<filter_view>(buf3.data,0),std::runtime_error);
+    BOOST_TEST_EQ(
+      boost::bloom::load_view<filter_view>(buf3.data,0,false).capacity(),
+      f.capacity());
+    str3[70]^=1;
+    str3[20]^=1; /* header */
+    BOOST_TEST_THROWS(load_from_string(f2,str3),std::runtime_error);
+
+    std::string str4=save_to_string(f);
+    str4.resize(str4.size()-1);
+    BOOST_TEST_THROWS(load_from_string(f2,str4),std::runtime_error);
+    BOOST_TEST_THROWS(load_from_string(f2,"BOOSTBLM"),std::runtime_error);
+  }
+}
+
+struct lambda
+{
+  template<typename T>
+  void operator()(T)
+  {
+    using filter=typename T::type;
+    using value_type=typename filter::value_type;
+
+    test_serialization<filter,value_factory<value_type>>();
+  }
+};
+
+int main()
+{
+  {
+    const char* str="123456789";
+    auto        p=reinterpret_cast<const unsigned char*>(str);
+
+    BOOST_TEST_EQ(boost::bloom::detail::crc32c(0,p,9),0xE3069283u);
+    BOOST_TEST_EQ(
+      boost::bloom::detail::crc32c(boost::bloom::detail::crc32c(0,p,4),p+4,5),
+      0xE3069283u);
+    BOOST_TEST_EQ(
+      ~boost::bloom::detail::crc32c_portable(0xFFFFFFFFu,p,9),0xE3069283u);
+
+    std::vector<unsigned char> v(1000);
+    for(std::size_t i=0;i<v.size();++i)v[i]=(unsigned char)(i*7+3);
+    BOOST_TEST_EQ(
+      boost::bloom::detail::crc32c(0,v.data(),v.size()),
+      ~boost::bloom::detail::crc32c_portable(0xFFFFFFFFu,v.data(),v.size()));
+  }
+
+  {
+    /* round trip of the compression codecs for different densities */
+
+    using namespace boost::bloom::detail;
+
+    std::mt19937_64 rng;
+    for(unsigned density:{0u,1u,10u,100u,200u,350u,500u}){ /* per 1000 */
+      std::vector<unsigned char> a(4099);
+      for(std::size_t i=0;i<a.size()*8;++i){
+        if(rng()%1000<density)a[i/8]|=(unsigned char)(1u<<(i%8));
+      }
+      auto num_ones=count_set_bits(a.data(),a.size());
+
+      for(unsigned r:{0u,1u,2u,4u,5u,17u,max_rice_parameter}){
+        for(std::uint32_t encoding:{sparse_encoding,rice_encoding}){
+          if(encoding==sparse_encoding&&r!=0)continue;
+
+          std::ostringstream out;
+          {
+            chunked_output output(out);
+            if(encoding==sparse_encoding){
+              encode_sparse(a.data(),a.size(),output);
+            }
+            else encode_rice(a.data(),a.size(),r,output);
+            output.flush();
+          }
+          auto str=out.str();
+
+          std::vector<unsigned char> b(a.size());
+          std::istringstream         in(str);
+          chunked_input              input(in,str.size());
+          if(encoding==sparse_encoding){
+            decode_sparse(b.data(),b.size(),num_ones,input);
+          }
+          else{
+            decode_rice(b.data(),b.size(),num_ones,r,input);
+          }
+          BOOST_TEST(a==b);
+        }
+      }
+
+      auto c=choose_encoding(a.data(),a.size(),24);
+      if(density==0)BOOST_TEST_EQ(c.encoding,sparse_encoding);
+      if(density==1||density==100||density==200){
+        BOOST_TEST_EQ(c.encoding,rice_encoding);
+      }
+      if(density==350||density==500){ /* too little gain */
+        BOOST_TEST_EQ(c.encoding,raw_encoding);
+      }
+    }
+  }
+
+  boost::mp11::mp_for_each<identity_test_types>(lambda{});
+
+  /* different subfilter with same sizes */
+
+  {
+    using filter1=boost::bloom::filter<
+      int,1,boost::bloom::block<std::uint64_t[2],2>>;
+    using filter2=boost::bloom::filter<
+      int,1,boost::bloom::multiblock<std::uint64_t,2>>;
+
+    std::ostringstream out;
+    boost::bloom::save(filter1(1000),out,0);
+    filter2 f;
+    std::istringstream in(out.str());
+    BOOST_TEST_THROWS(boost::bloom::load(f,in,0),std::runtime_error);
+  }
+
+  return boost::report_errors();
+}
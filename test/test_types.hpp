@@ -10,6 +10,8 @@
 #define BOOST_BLOOM_TEST_TEST_TYPES_HPP
 
 #include <boost/bloom/block.hpp>
+#include <boost/bloom/dispatched_fast_multiblock32.hpp>
+#include <boost/bloom/dispatched_fast_multiblock64.hpp>
 #include <boost/bloom/fast_multiblock32.hpp>
 #include <boost/bloom/fast_multiblock64.hpp>
 #include <boost/bloom/filter.hpp>
@@ -30,6 +32,15 @@ using test_types=boost::mp11::mp_list<
   boost::bloom::filter<
    int,1,boost::bloom::block<std::uint32_t[4],4>
   >,
+  boost::bloom::filter<
+   int,1,boost::bloom::block<std::uint64_t[8],5>,1
+  >,
+  boost::bloom::filter<
+   std::string,1,boost::bloom::block<std::uint64_t,5>
+  >,
+  boost::bloom::filter<
+   int,2,boost::bloom::block<std::uint64_t,6>,4
+  >,
   boost::bloom::filter<
     std::size_t,1,boost::bloom::multiblock<std::uint64_t,3>
   >,
@@ -41,6 +52,12 @@ using test_types=boost::mp11::mp_list<
   >,
   boost::bloom::filter<
     int,1,boost::bloom::fast_multiblock64<11>
+  >,
+  boost::bloom::filter<
+    std::string,1,boost::bloom::dispatched_fast_multiblock32<11>,12
+  >,
+  boost::bloom::filter<
+    int,2,boost::bloom::dispatched_fast_multiblock64<5>
   >
 >;
 
@@ -9,7 +9,13 @@
 #ifndef BOOST_BLOOM_TEST_TEST_UTILITIES_HPP
 #define BOOST_BLOOM_TEST_TEST_UTILITIES_HPP
 
+#include <algorithm>
+#include <boost/bloom/counting_filter.hpp>
+#include <boost/bloom/dynamic_filter.hpp>
 #include <boost/bloom/filter.hpp>
+#include <boost/bloom/filter_view.hpp>
+#include <cstddef>
+#include <iterator>
 #include <limits>
 #include <new>
 #include <string>
@@ -79,6 +85,129 @@ struct realloc_filter_impl<boost::bloom::filter<T,K,S,B,H,A>,Allocator>
 template<typename Filter,typename Allocator>
 using realloc_filter=typename realloc_filter_impl<Filter,Allocator>::type;
 
+template<typename Filter,std::size_t K>
+struct rek_filter_impl;
+
+template<
+  typename T,std::size_t K1,typename S,std::size_t B,typename H,typename A,
+  std::size_t K
+>
+struct rek_filter_impl<boost::bloom::filter<T,K1,S,B,H,A>,K>
+{
+  using type=boost::bloom::filter<T,K,S,B,H,A>;
+};
+
+template<typename Filter,std::size_t K>
+using rek_filter=typename rek_filter_impl<Filter,K>::type;
+
+/* Filter class templates with the same template parameters as filter
+ * (concurrent_filter, numa_filter) are passed as template template
+ * arguments so that their headers need not be included here.
+ */
+
+template<
+  typename Filter,
+  template<typename,std::size_t,typename,std::size_t,typename,typename>
+  class Template
+>
+struct retemplate_filter_impl;
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
+  template<typename,std::size_t,typename,std::size_t,typename,typename>
+  class Template
+>
+struct retemplate_filter_impl<boost::bloom::filter<T,K,S,B,H,A>,Template>
+{
+  using type=Template<T,K,S,B,H,A>;
+};
+
+template<
+  typename Filter,
+  template<typename,std::size_t,typename,std::size_t,typename,typename>
+  class Template
+>
+using retemplate_filter=
+  typename retemplate_filter_impl<Filter,Template>::type;
+
+template<typename Filter>
+struct filter_view_for_impl;
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A
+>
+struct filter_view_for_impl<boost::bloom::filter<T,K,S,B,H,A>>
+{
+  using type=boost::bloom::filter_view<T,K,S,B,H>;
+};
+
+template<typename Filter>
+using filter_view_for=typename filter_view_for_impl<Filter>::type;
+
+template<typename Filter>
+struct dynamic_filter_for_impl;
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A
+>
+struct dynamic_filter_for_impl<boost::bloom::filter<T,K,S,B,H,A>>
+{
+  using type=boost::bloom::dynamic_filter<T,S,B,H,A>;
+};
+
+template<typename Filter>
+using dynamic_filter_for=typename dynamic_filter_for_impl<Filter>::type;
+
+template<typename Filter,std::size_t CounterBits>
+struct counting_filter_for_impl;
+
+template<
+  typename T,std::size_t K,typename S,std::size_t B,typename H,typename A,
+  std::size_t CounterBits
+>
+struct counting_filter_for_impl<
+  boost::bloom::filter<T,K,S,B,H,A>,CounterBits>
+{
+  using type=boost::bloom::counting_filter<T,K,S,B,H,A,CounterBits>;
+};
+
+template<typename Filter,std::size_t CounterBits>
+using counting_filter_for=
+  typename counting_filter_for_impl<Filter,CounterBits>::type;
+
+template<typename Filter1,typename Filter2>
+bool same_array(const Filter1& f1,const Filter2& f2)
+{
+  auto x=f1.array();
+  auto y=f2.array();
+  return x.size()==y.size()&&std::equal(x.begin(),x.end(),y.begin());
+}
+
+template<typename Iterator>
+struct input_iterator
+{
+  using iterator_category=std::input_iterator_tag;
+  using value_type=typename std::iterator_traits<Iterator>::value_type;
+  using difference_type=
+    typename std::iterator_traits<Iterator>::difference_type;
+  using pointer=typename std::iterator_traits<Iterator>::pointer;
+  using reference=typename std::iterator_traits<Iterator>::reference;
+
+  reference operator*()const{return *it;}
+  input_iterator& operator++(){++it;return *this;}
+  input_iterator operator++(int){auto x=*this;++it;return x;}
+  bool operator==(const input_iterator& x)const{return it==x.it;}
+  bool operator!=(const input_iterator& x)const{return it!=x.it;}
+
+  Iterator it;
+};
+
+template<typename Iterator>
+input_iterator<Iterator> make_input_iterator(Iterator it)
+{
+  return {it};
+}
+
 void* capped_new(std::size_t n)
 {
   using limits=std::numeric_limits<std::size_t>;